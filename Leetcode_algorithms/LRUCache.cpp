@@ -74,8 +74,13 @@ public:
 	}
 };
 
+// 演示代码：被其他文件 #include 时（如 LRUCache_benchmark.cpp），定义 LRU_CACHE_NO_DEMO 跳过
+#ifndef LRU_CACHE_NO_DEMO
+
 int main()
 {
 
 	return 0;
 }
+
+#endif // LRU_CACHE_NO_DEMO
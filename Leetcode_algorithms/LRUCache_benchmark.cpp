@@ -0,0 +1,424 @@
+// LRUCache 基准测试与访问轨迹回放
+// 编译：g++ -std=c++20 -O2 -pthread LRUCache_benchmark.cpp -o lru_bench
+// 用法：./lru_bench [--capacity N] [--keys N] [--ops N] [--threads N] [--trace 文件路径]
+//
+// 轨迹文件格式：每行一个操作，"get <key>" / "put <key>"（可简写为 g / p），只有一个整数时视为 get
+#define LRU_CACHE_NO_DEMO
+#include "LRUCache.cpp"
+#include "LRUCache_sharded.cpp"
+#include "LRUCache_flat.cpp"
+#include "LRUCache_generic.cpp"
+#include "LRUCache_policies.cpp"
+#include "LRUCache_clock.cpp"
+#include "LRUCache_zipf.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <iomanip>
+#include <functional>
+
+using namespace std;
+
+/*
+ * 对每种实现、每种负载、每个线程数，报告：
+ * (1) 吞吐 ops/s
+ * (2) 命中率
+ * (3) get / put 各自的 p50 / p99 / p999 延迟 (ns)
+ * 负载：Zipf、均匀分布、Zipf + 周期性顺序扫描、以及从文件回放的真实轨迹
+ * 访问模式为“读穿透”：get 未命中后立即 put 回填
+ *
+ * 只有 ShardedLRUCache 和 ClockCache 自带同步，其余实现统一套一把全局锁（即业务中现在的用法），
+ * 这样单线程数字反映实现本身的开销，多线程数字反映锁竞争
+ */
+
+enum class OpType : uint8_t { Get, Put };
+
+struct Op
+{
+	OpType type;
+	int key;
+};
+
+// ---------------------------------------------------------------------------
+// 负载生成
+// ---------------------------------------------------------------------------
+struct Workload
+{
+	string name;
+	vector<vector<Op>> per_thread;		// 每个线程各自的操作序列
+};
+
+Workload make_zipf(size_t keys, size_t ops, int threads)
+{
+	Workload w{"zipf(0.99)", {}};
+	ZipfGenerator zipf(keys, 0.99);
+	for (int t = 0; t < threads; t++)
+	{
+		mt19937_64 gen(1000 + t);
+		vector<Op> seq(ops);
+		for (auto& op : seq)
+		{
+			op = Op{OpType::Get, zipf(gen)};
+		}
+		w.per_thread.push_back(std::move(seq));
+	}
+	return w;
+}
+
+Workload make_uniform(size_t keys, size_t ops, int threads)
+{
+	Workload w{"uniform", {}};
+	for (int t = 0; t < threads; t++)
+	{
+		mt19937_64 gen(2000 + t);
+		uniform_int_distribution<int> dis(0, static_cast<int>(keys) - 1);
+		vector<Op> seq(ops);
+		for (auto& op : seq)
+		{
+			op = Op{OpType::Get, dis(gen)};
+		}
+		w.per_thread.push_back(std::move(seq));
+	}
+	return w;
+}
+
+// Zipf 热点访问中周期性插入一段新 key 的顺序扫描（模拟批处理任务），热点段与扫描段长度为 5:1
+// 段长随 ops 缩放：热点段最长 10 万次，且每个线程的序列至少包含 4 轮扫描，--ops 较小时也不会退化成纯 Zipf
+Workload make_scan_mixed(size_t keys, size_t ops, int threads)
+{
+	Workload w{"zipf+scan", {}};
+	ZipfGenerator zipf(keys, 0.99);
+	const size_t hot_len = clamp<size_t>(ops * 5 / 24, 5, 100000);
+	const size_t scan_len = hot_len / 5;
+	for (int t = 0; t < threads; t++)
+	{
+		mt19937_64 gen(3000 + t);
+		int scan_key = static_cast<int>(keys + t * ops);
+		vector<Op> seq;
+		seq.reserve(ops);
+		while (seq.size() < ops)
+		{
+			for (size_t i = 0; i < hot_len && seq.size() < ops; i++)
+			{
+				seq.push_back(Op{OpType::Get, zipf(gen)});
+			}
+			for (size_t i = 0; i < scan_len && seq.size() < ops; i++)
+			{
+				seq.push_back(Op{OpType::Get, scan_key++});
+			}
+		}
+		w.per_thread.push_back(std::move(seq));
+	}
+	return w;
+}
+
+// 轨迹回放：整条轨迹按连续区间切分给各线程，保留每段内部的局部性
+bool load_trace(const string& path, int threads, Workload& w)
+{
+	ifstream in(path);
+	if (!in)
+	{
+		cerr << "无法打开轨迹文件: " << path << "\n";
+		return false;
+	}
+
+	vector<Op> all;
+	string line;
+	while (getline(in, line))
+	{
+		istringstream iss(line);
+		string first;
+		if (!(iss >> first) || first[0] == '#')
+		{
+			continue;
+		}
+
+		Op op{OpType::Get, 0};
+		string key_str = first;
+		if (first == "get" || first == "g" || first == "put" || first == "p")
+		{
+			op.type = (first[0] == 'p') ? OpType::Put : OpType::Get;
+			if (!(iss >> key_str))
+			{
+				continue;
+			}
+		}
+
+		try
+		{
+			op.key = stoi(key_str);
+		}
+		catch (const exception&)
+		{
+			// 非整数 key：取哈希值
+			op.key = static_cast<int>(hash<string>{}(key_str) & 0x7fffffff);
+		}
+		all.push_back(op);
+	}
+
+	w.name = "trace";
+	w.per_thread.assign(threads, {});
+	size_t chunk = (all.size() + threads - 1) / max(threads, 1);
+	for (int t = 0; t < threads; t++)
+	{
+		size_t begin = min(all.size(), t * chunk);
+		size_t end = min(all.size(), begin + chunk);
+		w.per_thread[t].assign(all.begin() + begin, all.begin() + end);
+	}
+	cout << "回放轨迹 " << path << "，共 " << all.size() << " 次操作，" << threads << " 个线程\n";
+	return !all.empty();
+}
+
+// ---------------------------------------------------------------------------
+// 被测实现：统一为 int get(int) / void put(int, int) 接口
+// ---------------------------------------------------------------------------
+template<typename Cache>
+class GlobalLocked
+{
+	mutex mtx_;
+	Cache cache_;
+
+public:
+	explicit GlobalLocked(size_t capacity) : cache_(capacity) {}
+
+	int get(int key)
+	{
+		lock_guard<mutex> lock(mtx_);
+		return cache_.get(key);
+	}
+
+	void put(int key, int value)
+	{
+		lock_guard<mutex> lock(mtx_);
+		cache_.put(key, value);
+	}
+};
+
+// GenericLRUCache 的接口适配：指针返回值转换为 -1 约定
+class GenericIntCache
+{
+	GenericLRUCache<int, int> cache_;
+
+public:
+	explicit GenericIntCache(size_t capacity) : cache_(capacity) {}
+
+	int get(int key)
+	{
+		int* v = cache_.get(key);
+		return v ? *v : -1;
+	}
+
+	void put(int key, int value)
+	{
+		cache_.insert_or_assign(key, value);
+	}
+};
+
+// ---------------------------------------------------------------------------
+// 统计
+// ---------------------------------------------------------------------------
+struct ThreadResult
+{
+	size_t hits = 0;
+	size_t gets = 0;
+	vector<uint32_t> get_ns;
+	vector<uint32_t> put_ns;
+};
+
+struct Percentiles
+{
+	uint32_t p50 = 0, p99 = 0, p999 = 0;
+};
+
+Percentiles percentiles(vector<uint32_t>& samples)
+{
+	Percentiles p;
+	if (samples.empty())
+	{
+		return p;
+	}
+
+	auto at = [&samples](double q)
+	{
+		size_t idx = min(samples.size() - 1, static_cast<size_t>(q * samples.size()));
+		nth_element(samples.begin(), samples.begin() + idx, samples.end());
+		return samples[idx];
+	};
+	p.p50 = at(0.50);
+	p.p99 = at(0.99);
+	p.p999 = at(0.999);
+	return p;
+}
+
+static inline uint32_t elapsed_ns(chrono::steady_clock::time_point start, chrono::steady_clock::time_point end)
+{
+	auto ns = chrono::duration_cast<chrono::nanoseconds>(end - start).count();
+	return static_cast<uint32_t>(min<long long>(ns, UINT32_MAX));
+}
+
+// 在给定负载上运行一个实现，打印一行结果
+template<typename Cache>
+void run_one(const string& impl, size_t capacity, const Workload& w)
+{
+	Cache cache(capacity);
+	int threads = static_cast<int>(w.per_thread.size());
+	vector<ThreadResult> results(threads);
+
+	auto worker = [&cache, &w, &results](int t)
+	{
+		const vector<Op>& seq = w.per_thread[t];
+		ThreadResult& r = results[t];
+		r.get_ns.reserve(seq.size());
+		r.put_ns.reserve(seq.size());
+
+		for (const Op& op : seq)
+		{
+			if (op.type == OpType::Put)
+			{
+				auto s = chrono::steady_clock::now();
+				cache.put(op.key, op.key);
+				r.put_ns.push_back(elapsed_ns(s, chrono::steady_clock::now()));
+				continue;
+			}
+
+			auto s = chrono::steady_clock::now();
+			int v = cache.get(op.key);
+			auto e = chrono::steady_clock::now();
+			r.get_ns.push_back(elapsed_ns(s, e));
+			r.gets++;
+
+			if (v != -1)
+			{
+				r.hits++;
+				continue;
+			}
+
+			// 读穿透：未命中后回填
+			s = chrono::steady_clock::now();
+			cache.put(op.key, op.key);
+			r.put_ns.push_back(elapsed_ns(s, chrono::steady_clock::now()));
+		}
+	};
+
+	auto start = chrono::steady_clock::now();
+	vector<thread> pool;
+	for (int t = 0; t < threads; t++)
+	{
+		pool.emplace_back(worker, t);
+	}
+	for (auto& th : pool)
+	{
+		th.join();
+	}
+	chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+	// 汇总各线程结果
+	ThreadResult total;
+	size_t ops = 0;
+	for (auto& r : results)
+	{
+		total.hits += r.hits;
+		total.gets += r.gets;
+		total.get_ns.insert(total.get_ns.end(), r.get_ns.begin(), r.get_ns.end());
+		total.put_ns.insert(total.put_ns.end(), r.put_ns.begin(), r.put_ns.end());
+		ops += r.get_ns.size() + r.put_ns.size();
+	}
+
+	Percentiles g = percentiles(total.get_ns);
+	Percentiles p = percentiles(total.put_ns);
+	double hit_ratio = total.gets ? static_cast<double>(total.hits) / total.gets : 0.0;
+
+	cout << left << setw(12) << w.name.substr(0, 12) << setw(22) << impl << right
+		 << setw(4) << threads
+		 << setw(13) << static_cast<long long>(ops / elapsed.count())
+		 << setw(8) << fixed << setprecision(3) << hit_ratio
+		 << setw(8) << g.p50 << setw(8) << g.p99 << setw(9) << g.p999
+		 << setw(8) << p.p50 << setw(8) << p.p99 << setw(9) << p.p999 << "\n";
+}
+
+void run_all(size_t capacity, const Workload& w)
+{
+	run_one<GlobalLocked<LRUCache>>("LRUCache(list+map)", capacity, w);
+	run_one<GlobalLocked<FlatLRUCache>>("FlatLRUCache", capacity, w);
+	run_one<GlobalLocked<GenericIntCache>>("GenericLRUCache", capacity, w);
+	run_one<ShardedLRUCache>("ShardedLRUCache", capacity, w);
+	run_one<ClockCache>("ClockCache", capacity, w);
+	run_one<GlobalLocked<PolicyCache<WTinyLFUPolicy>>>("W-TinyLFU", capacity, w);
+	run_one<GlobalLocked<PolicyCache<S3FIFOPolicy>>>("S3-FIFO", capacity, w);
+	run_one<GlobalLocked<PolicyCache<ARCPolicy>>>("ARC", capacity, w);
+}
+
+int main(int argc, char* argv[])
+{
+	size_t capacity = 1 << 14;
+	size_t keys = 1 << 18;
+	size_t ops = 500000;
+	int max_threads = static_cast<int>(max(1u, thread::hardware_concurrency()));
+	string trace_path;
+
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		string flag = argv[i];
+		string value = argv[i + 1];
+		if (flag == "--capacity")
+		{
+			capacity = stoul(value);
+		}
+		else if (flag == "--keys")
+		{
+			keys = stoul(value);
+		}
+		else if (flag == "--ops")
+		{
+			ops = stoul(value);
+		}
+		else if (flag == "--threads")
+		{
+			max_threads = max(1, stoi(value));
+		}
+		else if (flag == "--trace")
+		{
+			trace_path = value;
+		}
+		else
+		{
+			cerr << "未知参数: " << flag << "\n";
+			return 1;
+		}
+	}
+
+	cout << "容量 " << capacity << "，key 空间 " << keys << "，每线程 " << ops << " 次操作\n";
+	cout << left << setw(12) << "workload" << setw(22) << "impl" << right
+		 << setw(4) << "thr" << setw(13) << "ops/s" << setw(8) << "hit"
+		 << setw(8) << "get50" << setw(8) << "get99" << setw(9) << "get999"
+		 << setw(8) << "put50" << setw(8) << "put99" << setw(9) << "put999" << "\n";
+
+	// 线程数：1, 2, 4 ... 直到上限（最后一档补上上限本身）
+	vector<int> thread_counts;
+	for (int t = 1; t < max_threads; t *= 2)
+	{
+		thread_counts.push_back(t);
+	}
+	thread_counts.push_back(max_threads);
+
+	for (int threads : thread_counts)
+	{
+		if (!trace_path.empty())
+		{
+			Workload w;
+			if (!load_trace(trace_path, threads, w))
+			{
+				return 1;
+			}
+			run_all(capacity, w);
+			continue;
+		}
+
+		run_all(capacity, make_zipf(keys, ops, threads));
+		run_all(capacity, make_uniform(keys, ops, threads));
+		run_all(capacity, make_scan_mixed(keys, ops, threads));
+	}
+
+	return 0;
+}
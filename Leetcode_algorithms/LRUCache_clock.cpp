@@ -0,0 +1,285 @@
+#include <iostream>
+#include <vector>
+#include <unordered_map>
+#include <shared_mutex>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+
+/*
+ * LeetCode 146: LRU 缓存 —— CLOCK（二次机会）近似 LRU
+ * 原版每次命中都要 cache_list_.splice(...)，读操作也在改链表，并发时只能上独占锁
+ * 做法：条目放在环形数组中，每个条目带一个“访问位”
+ * (1) 命中：只把访问位置 1（原子写），不移动任何数据 —— 读者之间只需共享锁 (shared_lock)
+ * (2) 淘汰：时钟指针沿环扫描，访问位为 1 的清零并跳过（给第二次机会），遇到 0 的即淘汰
+ * (3) 同样按 key 分片，每个分片一把读写锁，写操作之间的竞争也被分散
+ * 代价：淘汰顺序是 LRU 的近似
+ */
+
+class ClockCache
+{
+	struct Slot
+	{
+		int key = 0;
+		int value = 0;
+	};
+
+	// 分片：读写锁 + 环形数组 + 哈希表
+	struct alignas(64) Shard
+	{
+		shared_mutex mtx_;
+		size_t capacity_ = 0;
+		size_t size_ = 0;
+		size_t hand_ = 0;
+
+		vector<Slot> slots_;
+
+		// 访问位：读者在共享锁下并发写入，因此是原子变量
+		unique_ptr<atomic<uint8_t>[]> referenced_;
+
+		// 哈希表：key -> 槽位下标，只在独占锁下修改
+		unordered_map<int, uint32_t> key_to_slot_;
+	};
+
+	unique_ptr<Shard[]> shards_;
+	size_t num_shards_;
+	size_t shard_mask_;
+	size_t capacity_;
+
+	static size_t mix(int key)
+	{
+		uint64_t h = static_cast<uint32_t>(key);
+		h ^= h >> 33;
+		h *= 0xff51afd7ed558ccdULL;
+		h ^= h >> 33;
+		h *= 0xc4ceb9fe1a85ec53ULL;
+		h ^= h >> 33;
+		return static_cast<size_t>(h);
+	}
+
+	Shard& shard_for(int key)
+	{
+		return shards_[mix(key) & shard_mask_];
+	}
+
+	// 先读后写：访问位已经是 1 时不再写，避免热点 key 的缓存行在读者之间来回失效
+	static void mark(atomic<uint8_t>& bit) noexcept
+	{
+		if (!bit.load(memory_order_relaxed))
+		{
+			bit.store(1, memory_order_relaxed);
+		}
+	}
+
+	// 转动时钟指针，找到第一个访问位为 0 的槽位（调用方持有独占锁）
+	static size_t find_victim(Shard& shard) noexcept
+	{
+		while (true)
+		{
+			size_t i = shard.hand_;
+			shard.hand_ = (shard.hand_ + 1 == shard.capacity_) ? 0 : shard.hand_ + 1;
+
+			if (shard.referenced_[i].load(memory_order_relaxed))
+			{
+				shard.referenced_[i].store(0, memory_order_relaxed);
+				continue;
+			}
+			return i;
+		}
+	}
+
+public:
+	// num_shards 为 0 时，按 CPU 核数的 4 倍自动选择
+	explicit ClockCache(size_t capacity, size_t num_shards = 0) : capacity_(capacity)
+	{
+		if (num_shards == 0)
+		{
+			num_shards = max<size_t>(1, thread::hardware_concurrency()) * 4;
+		}
+
+		size_t n = 1;
+		while (n < num_shards)
+		{
+			n <<= 1;
+		}
+		while (n > 1 && n > capacity_)
+		{
+			n >>= 1;
+		}
+
+		num_shards_ = n;
+		shard_mask_ = n - 1;
+		shards_ = make_unique<Shard[]>(n);
+
+		for (size_t i = 0; i < num_shards_; i++)
+		{
+			Shard& shard = shards_[i];
+			shard.capacity_ = capacity_ / num_shards_ + (i < capacity_ % num_shards_ ? 1 : 0);
+			shard.slots_.resize(shard.capacity_);
+			shard.referenced_ = make_unique<atomic<uint8_t>[]>(shard.capacity_);
+			shard.key_to_slot_.reserve(shard.capacity_);
+		}
+	}
+
+	// 禁用拷贝构造和赋值运算符
+	ClockCache(const ClockCache& other) = delete;
+	ClockCache& operator=(const ClockCache& other) = delete;
+
+	// 查询：共享锁，命中时只设置访问位
+	int get(int key)
+	{
+		Shard& shard = shard_for(key);
+		shared_lock<shared_mutex> lock(shard.mtx_);
+
+		auto it = shard.key_to_slot_.find(key);
+		if (it == shard.key_to_slot_.end())
+		{
+			return -1;
+		}
+
+		mark(shard.referenced_[it->second]);
+		return shard.slots_[it->second].value;
+	}
+
+	// 存入：独占锁，未命中时由时钟指针选出被淘汰的槽位
+	void put(int key, int value)
+	{
+		Shard& shard = shard_for(key);
+		unique_lock<shared_mutex> lock(shard.mtx_);
+
+		auto it = shard.key_to_slot_.find(key);
+		if (it != shard.key_to_slot_.end())
+		{
+			shard.slots_[it->second].value = value;
+			mark(shard.referenced_[it->second]);
+			return;
+		}
+
+		if (shard.capacity_ == 0)
+		{
+			return;
+		}
+
+		size_t i;
+		if (shard.size_ < shard.capacity_)
+		{
+			i = shard.size_++;
+		}
+		else
+		{
+			i = find_victim(shard);
+			shard.key_to_slot_.erase(shard.slots_[i].key);
+		}
+
+		// 新条目访问位为 0：若在指针转一圈之前没有被再次访问，就会被淘汰
+		shard.slots_[i] = Slot{key, value};
+		shard.referenced_[i].store(0, memory_order_relaxed);
+		shard.key_to_slot_.emplace(key, static_cast<uint32_t>(i));
+	}
+
+	size_t size()
+	{
+		size_t total = 0;
+		for (size_t i = 0; i < num_shards_; i++)
+		{
+			shared_lock<shared_mutex> lock(shards_[i].mtx_);
+			total += shards_[i].size_;
+		}
+		return total;
+	}
+
+	size_t capacity() const noexcept
+	{
+		return capacity_;
+	}
+
+	size_t shard_count() const noexcept
+	{
+		return num_shards_;
+	}
+};
+
+// 演示代码：被其他文件 #include 时（如 LRUCache_benchmark.cpp），定义 LRU_CACHE_NO_DEMO 跳过
+#ifndef LRU_CACHE_NO_DEMO
+
+// 防止编译器把读取结果优化掉
+atomic<long long> g_sink{0};
+
+// 读多写少负载：key 空间与容量相同，预热后几乎全部命中，只测读路径的扩展性
+double run_readers(ClockCache& cache, int num_threads, int ops_per_thread, int key_space)
+{
+	vector<thread> threads;
+	auto start = chrono::steady_clock::now();
+
+	for (int t = 0; t < num_threads; t++)
+	{
+		threads.emplace_back([&cache, ops_per_thread, key_space, t]
+		{
+			mt19937 gen(t + 1);
+			uniform_int_distribution<int> dis(0, key_space - 1);
+			long long sum = 0;
+			for (int i = 0; i < ops_per_thread; i++)
+			{
+				int key = dis(gen);
+				int v = cache.get(key);
+				if (v == -1)
+				{
+					cache.put(key, key);
+				}
+				else
+				{
+					sum += v;
+				}
+			}
+			g_sink.fetch_add(sum, memory_order_relaxed);
+		});
+	}
+
+	for (auto& th : threads)
+	{
+		th.join();
+	}
+
+	chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+	return num_threads * static_cast<double>(ops_per_thread) / elapsed.count();
+}
+
+int main()
+{
+	// 基本功能：容量 2，单分片
+	ClockCache clock_cache(2, 1);
+	clock_cache.put(1, 1);
+	clock_cache.put(2, 2);
+	cout << clock_cache.get(1) << "\n";		// 1，key 1 获得访问位
+	clock_cache.put(3, 3);					// 指针跳过 key 1（清除访问位），淘汰 key 2
+	cout << clock_cache.get(2) << "\n";		// -1
+	cout << clock_cache.get(1) << " " << clock_cache.get(3) << "\n";	// 1 3
+
+	// 读扩展性：单分片（一把读写锁）与多分片
+	const int key_space = 1 << 14;
+	const int ops_per_thread = 1000000;
+	int max_threads = static_cast<int>(max(1u, thread::hardware_concurrency()));
+	for (int threads = 1; threads <= max_threads; threads *= 2)
+	{
+		ClockCache single(key_space, 1);
+		ClockCache sharded(key_space);
+
+		double a = run_readers(single, threads, ops_per_thread, key_space);
+		double b = run_readers(sharded, threads, ops_per_thread, key_space);
+
+		cout << "线程数 " << threads
+			 << " | 单分片读写锁: " << static_cast<long long>(a) << " ops/s"
+			 << " | " << sharded.shard_count() << " 分片: " << static_cast<long long>(b) << " ops/s\n";
+	}
+
+	return 0;
+}
+
+#endif // LRU_CACHE_NO_DEMO
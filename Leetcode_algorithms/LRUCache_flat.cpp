@@ -0,0 +1,507 @@
+#include <iostream>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <random>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <algorithm>
+
+using namespace std;
+
+// 软件预取：提前把即将访问的缓存行拉进 CPU 缓存
+#if defined(__GNUC__) || defined(__clang__)
+#define LRU_PREFETCH(addr) __builtin_prefetch(addr)
+#elif defined(_MSC_VER)
+#include <xmmintrin.h>
+#define LRU_PREFETCH(addr) _mm_prefetch(reinterpret_cast<const char*>(addr), _MM_HINT_T0)
+#else
+#define LRU_PREFETCH(addr) ((void)(addr))
+#endif
+
+/*
+ * LeetCode 146: LRU 缓存 —— 无堆分配的扁平版本
+ * 原版每次 put 未命中都要 new 一个 list 节点 + 一个 unordered_map 节点，淘汰时再各释放一次
+ * 做法：容量在构造时固定，所有内存一次性申请
+ * (1) 双向链表：节点放在一段连续数组里，prev/next 用下标而不是指针链接
+ * (2) 哈希表：开放寻址 + 线性探测，删除时做“后移”(backward shift)，不留墓碑
+ * 稳态下 get/put 完全不触碰分配器
+ *
+ * 批量接口 get_many / put_many：
+ * 逐个 get 时，每个 key 都要串行等待“哈希槽 -> 节点”两次缓存未命中
+ * 批量版本分三趟处理一组 key：先算哈希并预取槽位，再探测并预取节点，最后统一解析结果，
+ * 让多个 key 的内存访问延迟相互重叠
+ */
+
+class FlatLRUCache
+{
+	static constexpr uint32_t NIL = UINT32_MAX;
+
+	// 链表节点：按下标互相链接
+	struct Node
+	{
+		int key;
+		int value;
+		uint32_t prev;
+		uint32_t next;
+	};
+
+	// 哈希槽：顺带存 key，探测时只需比较槽位，不必跳到节点数组
+	struct Slot
+	{
+		int key;
+		uint32_t node;		// NIL 表示空槽
+	};
+
+	size_t capacity_;
+	size_t size_ = 0;
+
+	// 节点数组：下标 capacity_ 处为哨兵，构成循环双向链表
+	// 哨兵的 next 是最新节点，prev 是最旧节点
+	vector<Node> nodes_;
+
+	// 哈希表：大小为 2 的幂，且不少于容量的 2 倍，负载因子 <= 0.5
+	vector<Slot> slots_;
+	size_t slot_mask_;
+
+	uint32_t sentinel() const noexcept
+	{
+		return static_cast<uint32_t>(capacity_);
+	}
+
+	static size_t mix(int key) noexcept
+	{
+		uint64_t h = static_cast<uint32_t>(key);
+		h ^= h >> 33;
+		h *= 0xff51afd7ed558ccdULL;
+		h ^= h >> 33;
+		h *= 0xc4ceb9fe1a85ec53ULL;
+		h ^= h >> 33;
+		return static_cast<size_t>(h);
+	}
+
+	// 链表操作：摘下节点 / 挂到表头
+	void unlink(uint32_t i) noexcept
+	{
+		nodes_[nodes_[i].prev].next = nodes_[i].next;
+		nodes_[nodes_[i].next].prev = nodes_[i].prev;
+	}
+
+	void push_front(uint32_t i) noexcept
+	{
+		uint32_t s = sentinel();
+		nodes_[i].prev = s;
+		nodes_[i].next = nodes_[s].next;
+		nodes_[nodes_[s].next].prev = i;
+		nodes_[s].next = i;
+	}
+
+	void move_to_front(uint32_t i) noexcept
+	{
+		if (nodes_[sentinel()].next != i)
+		{
+			unlink(i);
+			push_front(i);
+		}
+	}
+
+	// 查找 key 所在的槽位；不存在时返回探测链上第一个空槽
+	size_t find_slot(int key) const noexcept
+	{
+		return find_slot(key, mix(key));
+	}
+
+	size_t find_slot(int key, size_t hash) const noexcept
+	{
+		size_t pos = hash & slot_mask_;
+		while (slots_[pos].node != NIL && slots_[pos].key != key)
+		{
+			pos = (pos + 1) & slot_mask_;
+		}
+		return pos;
+	}
+
+	// 后移删除：把探测链上后续元素前移填补空洞，保证查找不会被提前截断
+	void erase_slot(size_t hole) noexcept
+	{
+		size_t next = (hole + 1) & slot_mask_;
+		while (slots_[next].node != NIL)
+		{
+			size_t ideal = mix(slots_[next].key) & slot_mask_;
+
+			// ideal 不在 (hole, next] 的循环区间内，说明该元素可以前移到 hole
+			bool movable = (hole <= next) ? (ideal <= hole || ideal > next)
+										  : (ideal <= hole && ideal > next);
+			if (movable)
+			{
+				slots_[hole] = slots_[next];
+				hole = next;
+			}
+			next = (next + 1) & slot_mask_;
+		}
+		slots_[hole].node = NIL;
+	}
+
+	// 存入（哈希值已算好）
+	void put_hashed(int key, int value, size_t hash) noexcept
+	{
+		if (capacity_ == 0)
+		{
+			return;
+		}
+
+		size_t pos = find_slot(key, hash);
+		if (slots_[pos].node != NIL)
+		{
+			uint32_t i = slots_[pos].node;
+			nodes_[i].value = value;
+			move_to_front(i);
+			return;
+		}
+
+		uint32_t i;
+		if (size_ < capacity_)
+		{
+			// 还有未使用的节点，直接取下一个
+			i = static_cast<uint32_t>(size_++);
+		}
+		else
+		{
+			// 空间已满：最旧节点位于哨兵的 prev，复用它的位置
+			i = nodes_[sentinel()].prev;
+			unlink(i);
+			erase_slot(find_slot(nodes_[i].key));
+
+			// 后移删除可能挪动了槽位，重新定位插入点
+			pos = find_slot(key, hash);
+		}
+
+		nodes_[i].key = key;
+		nodes_[i].value = value;
+		push_front(i);
+		slots_[pos] = Slot{key, i};
+	}
+
+	// 每组同时在途的 key 数量：足以覆盖内存延迟，又不至于把预取的缓存行挤出 L1
+	static constexpr size_t BATCH = 16;
+
+public:
+	explicit FlatLRUCache(size_t capacity) : capacity_(capacity)
+	{
+		// 一次性申请所有节点（含哨兵）
+		nodes_.resize(capacity_ + 1);
+		nodes_[sentinel()].prev = sentinel();
+		nodes_[sentinel()].next = sentinel();
+
+		size_t table_size = 1;
+		while (table_size < capacity_ * 2)
+		{
+			table_size <<= 1;
+		}
+		slots_.assign(table_size, Slot{0, NIL});
+		slot_mask_ = table_size - 1;
+	}
+
+	// 禁用拷贝构造和赋值运算符
+	FlatLRUCache(const FlatLRUCache& other) = delete;
+	FlatLRUCache& operator=(const FlatLRUCache& other) = delete;
+
+	// 查询：查到则移到表头，查不到返回 -1
+	int get(int key) noexcept
+	{
+		size_t pos = find_slot(key);
+		if (slots_[pos].node == NIL)
+		{
+			return -1;
+		}
+
+		uint32_t i = slots_[pos].node;
+		move_to_front(i);
+		return nodes_[i].value;
+	}
+
+	// 存入：查到则更新值，查不到则复用空闲节点或淘汰最旧节点
+	void put(int key, int value) noexcept
+	{
+		put_hashed(key, value, mix(key));
+	}
+
+	// 批量查询：values[i] 为 keys[i] 的结果（未命中为 -1）
+	// misses 非空时由调用方提供至少 n 个元素的空间，按顺序写入未命中的下标，共 n - 返回值 个
+	// 访问顺序的更新与逐个调用 get 完全一致；返回命中个数；不分配内存
+	size_t get_many(const int* keys, size_t n, int* values, size_t* misses = nullptr) noexcept
+	{
+		size_t hashes[BATCH];
+		uint32_t found[BATCH];
+		size_t hits = 0;
+		size_t miss_count = 0;
+
+		for (size_t base = 0; base < n; base += BATCH)
+		{
+			size_t count = min(BATCH, n - base);
+
+			// 第一趟：计算哈希，预取槽位
+			for (size_t j = 0; j < count; j++)
+			{
+				hashes[j] = mix(keys[base + j]);
+				LRU_PREFETCH(&slots_[hashes[j] & slot_mask_]);
+			}
+
+			// 第二趟：探测槽位，预取命中的节点
+			for (size_t j = 0; j < count; j++)
+			{
+				size_t pos = find_slot(keys[base + j], hashes[j]);
+				found[j] = slots_[pos].node;
+				if (found[j] != NIL)
+				{
+					LRU_PREFETCH(&nodes_[found[j]]);
+				}
+			}
+
+			// 第三趟：读取结果并更新访问顺序
+			for (size_t j = 0; j < count; j++)
+			{
+				if (found[j] == NIL)
+				{
+					values[base + j] = -1;
+					if (misses)
+					{
+						misses[miss_count++] = base + j;
+					}
+					continue;
+				}
+
+				move_to_front(found[j]);
+				values[base + j] = nodes_[found[j]].value;
+				hits++;
+			}
+		}
+		return hits;
+	}
+
+	// vector 版本：misses 被替换为未命中的下标（会分配内存）
+	size_t get_many(const vector<int>& keys, vector<int>& values, vector<size_t>* misses = nullptr)
+	{
+		values.resize(keys.size());
+		if (!misses)
+		{
+			return get_many(keys.data(), keys.size(), values.data());
+		}
+		misses->resize(keys.size());
+		size_t hits = get_many(keys.data(), keys.size(), values.data(), misses->data());
+		misses->resize(keys.size() - hits);
+		return hits;
+	}
+
+	// 批量存入：先统一算哈希并预取槽位，再按顺序逐个存入（结果与逐个 put 一致）
+	void put_many(const int* keys, const int* values, size_t n) noexcept
+	{
+		size_t hashes[BATCH];
+
+		for (size_t base = 0; base < n; base += BATCH)
+		{
+			size_t count = min(BATCH, n - base);
+
+			for (size_t j = 0; j < count; j++)
+			{
+				hashes[j] = mix(keys[base + j]);
+				LRU_PREFETCH(&slots_[hashes[j] & slot_mask_]);
+			}
+
+			// 存入过程中可能淘汰最旧节点，顺带预取它
+			LRU_PREFETCH(&nodes_[nodes_[sentinel()].prev]);
+
+			for (size_t j = 0; j < count; j++)
+			{
+				put_hashed(keys[base + j], values[base + j], hashes[j]);
+			}
+		}
+	}
+
+	void put_many(const vector<int>& keys, const vector<int>& values) noexcept
+	{
+		put_many(keys.data(), values.data(), min(keys.size(), values.size()));
+	}
+
+	size_t size() const noexcept
+	{
+		return size_;
+	}
+
+	size_t capacity() const noexcept
+	{
+		return capacity_;
+	}
+};
+
+// 演示代码：被其他文件 #include 时（如 LRUCache_benchmark.cpp），定义 LRU_CACHE_NO_DEMO 跳过
+#ifndef LRU_CACHE_NO_DEMO
+
+// 对照组：与原版 LRUCache 相同的 list + unordered_map 实现
+class ListLRUCache
+{
+	using CacheNode = pair<int, int>;
+
+	size_t capacity_;
+	list<CacheNode> cache_list_;
+	unordered_map<int, list<CacheNode>::iterator> key_to_iter_;
+
+public:
+	explicit ListLRUCache(size_t capacity) : capacity_(capacity) {}
+
+	int get(int key)
+	{
+		auto it = key_to_iter_.find(key);
+		if (it == key_to_iter_.end())
+		{
+			return -1;
+		}
+		cache_list_.splice(cache_list_.begin(), cache_list_, it->second);
+		return it->second->second;
+	}
+
+	void put(int key, int value)
+	{
+		auto it = key_to_iter_.find(key);
+		if (it != key_to_iter_.end())
+		{
+			it->second->second = value;
+			cache_list_.splice(cache_list_.begin(), cache_list_, it->second);
+			return;
+		}
+		if (cache_list_.size() >= capacity_)
+		{
+			key_to_iter_.erase(cache_list_.back().first);
+			cache_list_.pop_back();
+		}
+		cache_list_.emplace_front(key, value);
+		key_to_iter_[key] = cache_list_.begin();
+	}
+};
+
+// 统计全局 operator new 的调用次数，用来验证稳态下没有堆分配
+static size_t g_alloc_count = 0;
+
+void* operator new(size_t size)
+{
+	g_alloc_count++;
+	if (void* p = malloc(size))
+	{
+		return p;
+	}
+	throw bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+	free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+	free(p);
+}
+
+// 随机 get/put 混合负载，返回每次操作的平均耗时 (ns) 和期间的分配次数
+template<typename Cache>
+void run_workload(const char* name, Cache& cache, const vector<int>& keys)
+{
+	size_t allocs_before = g_alloc_count;
+	auto start = chrono::steady_clock::now();
+
+	long long checksum = 0;
+	for (int key : keys)
+	{
+		int v = cache.get(key);
+		if (v == -1)
+		{
+			cache.put(key, key);
+		}
+		else
+		{
+			checksum += v;
+		}
+	}
+
+	chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+	cout << name << ": " << elapsed.count() / keys.size() << " ns/op, "
+		 << "堆分配 " << g_alloc_count - allocs_before << " 次 (checksum " << checksum << ")\n";
+}
+
+int main()
+{
+	// 基本功能：与 LeetCode 146 示例一致
+	FlatLRUCache lru(2);
+	lru.put(1, 1);
+	lru.put(2, 2);
+	cout << lru.get(1) << "\n";		// 1
+	lru.put(3, 3);					// 淘汰 key 2
+	cout << lru.get(2) << "\n";		// -1
+	lru.put(4, 4);					// 淘汰 key 1
+	cout << lru.get(1) << " " << lru.get(3) << " " << lru.get(4) << "\n";	// -1 3 4
+
+	// 性能对比：key 空间是容量的 4 倍，保证持续有淘汰
+	const size_t capacity = 1 << 14;
+	mt19937 gen(42);
+	uniform_int_distribution<int> dis(0, static_cast<int>(capacity * 4));
+	vector<int> keys(2000000);
+	for (auto& k : keys)
+	{
+		k = dis(gen);
+	}
+
+	FlatLRUCache flat(capacity);
+	ListLRUCache list_based(capacity);
+	run_workload("FlatLRUCache", flat, keys);
+	run_workload("list + unordered_map", list_based, keys);
+
+	// 批量接口：缓存远大于 CPU 缓存时，逐个 get 与 get_many 的每 key 耗时对比
+	const size_t big_capacity = 1 << 21;
+	const size_t batch_size = 128;
+	FlatLRUCache big(big_capacity);
+	vector<int> fill_keys(big_capacity);
+	for (size_t i = 0; i < big_capacity; i++)
+	{
+		fill_keys[i] = static_cast<int>(i);
+	}
+	big.put_many(fill_keys, fill_keys);
+
+	uniform_int_distribution<int> big_dis(0, static_cast<int>(big_capacity * 5 / 4));
+	vector<int> lookups(batch_size * 8192);
+	for (auto& k : lookups)
+	{
+		k = big_dis(gen);
+	}
+
+	long long loop_sum = 0;
+	auto start = chrono::steady_clock::now();
+	for (int key : lookups)
+	{
+		loop_sum += big.get(key);
+	}
+	chrono::duration<double, nano> loop_time = chrono::steady_clock::now() - start;
+
+	long long batch_sum = 0;
+	vector<int> values(batch_size);
+	size_t misses[batch_size];
+	size_t miss_total = 0;
+	start = chrono::steady_clock::now();
+	for (size_t base = 0; base < lookups.size(); base += batch_size)
+	{
+		miss_total += batch_size - big.get_many(lookups.data() + base, batch_size, values.data(), misses);
+		for (int v : values)
+		{
+			batch_sum += v;
+		}
+	}
+	chrono::duration<double, nano> batch_time = chrono::steady_clock::now() - start;
+
+	cout << "逐个 get: " << loop_time.count() / lookups.size() << " ns/key (sum " << loop_sum << ")\n";
+	cout << "get_many: " << batch_time.count() / lookups.size() << " ns/key (sum " << batch_sum << ", 未命中 " << miss_total << ")\n";
+
+	return 0;
+}
+
+#endif // LRU_CACHE_NO_DEMO
@@ -0,0 +1,311 @@
+#include <iostream>
+#include <list>
+#include <unordered_map>
+#include <string>
+#include <string_view>
+#include <functional>
+#include <memory>
+#include <concepts>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/*
+ * LeetCode 146: LRU 缓存 —— 泛型版本 GenericLRUCache<K, V, Hash, KeyEqual>（需要 C++20）
+ * 原版写死 pair<int, int>，且 get() 以 -1 作为未命中标记、按值返回结果
+ * 改进：
+ * (1) 任意 key/value 类型，value 可以是只能移动的类型（如 unique_ptr）
+ * (2) get() 返回指针，未命中返回 nullptr，命中时不拷贝 value
+ * (3) 异构查找：Hash/KeyEqual 声明 is_transparent 时，可以直接用 string_view 查 string 类型的 key，不构造临时对象
+ * (4) try_emplace 原地构造 value；key 只在链表节点中存一份，哈希表里存的是指向它的指针
+ * (5) try_emplace / insert_or_assign 先用传入的 key 查找，只在未命中时构造 K；先插入新条目再淘汰，插入失败时缓存保持原样
+ */
+
+// 透明的字符串哈希：string / string_view / const char* 得到相同的哈希值
+struct StringHash
+{
+	using is_transparent = void;
+
+	size_t operator()(string_view sv) const noexcept
+	{
+		return hash<string_view>{}(sv);
+	}
+};
+
+template<typename K, typename V, typename Hash = hash<K>, typename KeyEqual = equal_to<K>>
+class GenericLRUCache
+{
+	using CacheNode = pair<K, V>;
+	using ListIter = typename list<CacheNode>::iterator;
+
+	// 哈希表的 key：指向链表节点里的 key，避免 key 存两份
+	struct KeyRef
+	{
+		const K* key;
+	};
+
+	// 包装用户提供的 Hash/KeyEqual，使其能同时处理 KeyRef 和查询类型 Q
+	struct RefHash
+	{
+		using is_transparent = void;
+		Hash hash_;
+
+		size_t operator()(const KeyRef& ref) const
+		{
+			return hash_(*ref.key);
+		}
+
+		template<typename Q>
+		size_t operator()(const Q& q) const
+		{
+			return hash_(q);
+		}
+	};
+
+	struct RefEqual
+	{
+		using is_transparent = void;
+		KeyEqual equal_;
+
+		bool operator()(const KeyRef& a, const KeyRef& b) const
+		{
+			return equal_(*a.key, *b.key);
+		}
+
+		template<typename Q>
+		bool operator()(const Q& q, const KeyRef& ref) const
+		{
+			return equal_(q, *ref.key);
+		}
+
+		template<typename Q>
+		bool operator()(const KeyRef& ref, const Q& q) const
+		{
+			return equal_(*ref.key, q);
+		}
+	};
+
+	// 用户的 Hash 和 KeyEqual 都是透明的，才允许用 K 以外的类型查找
+	template<typename Q>
+	static constexpr bool is_heterogeneous =
+		!is_same_v<remove_cvref_t<Q>, K> && requires { typename Hash::is_transparent; typename KeyEqual::is_transparent; };
+
+	size_t capacity_;
+
+	// 双向链表：节点中保存 key 和 value
+	list<CacheNode> cache_list_;
+
+	// 哈希表
+	unordered_map<KeyRef, ListIter, RefHash, RefEqual> key_to_iter_;
+
+	template<typename Q>
+	auto find_iter(const Q& key)
+	{
+		if constexpr (is_heterogeneous<Q>)
+		{
+			return key_to_iter_.find(key);
+		}
+		else
+		{
+			const K& k = key;
+			return key_to_iter_.find(KeyRef{&k});
+		}
+	}
+
+	template<typename Q>
+	auto find_iter(const Q& key) const
+	{
+		if constexpr (is_heterogeneous<Q>)
+		{
+			return key_to_iter_.find(key);
+		}
+		else
+		{
+			const K& k = key;
+			return key_to_iter_.find(KeyRef{&k});
+		}
+	}
+
+	// 未命中时插入新条目：先构造并登记新节点，成功后再淘汰最旧的值
+	// 哈希表插入抛出异常时撤销链表节点，缓存保持原样
+	template<typename KK, typename... Args>
+	V* emplace_new(KK&& key, Args&&... args)
+	{
+		cache_list_.emplace_front(piecewise_construct, forward_as_tuple(std::forward<KK>(key)), forward_as_tuple(std::forward<Args>(args)...));
+		try
+		{
+			key_to_iter_.emplace(KeyRef{&cache_list_.front().first}, cache_list_.begin());
+		}
+		catch (...)
+		{
+			cache_list_.pop_front();
+			throw;
+		}
+
+		if (cache_list_.size() > capacity_)
+		{
+			key_to_iter_.erase(KeyRef{&cache_list_.back().first});
+			cache_list_.pop_back();
+		}
+		return &cache_list_.front().second;
+	}
+
+public:
+	explicit GenericLRUCache(size_t capacity, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+		: capacity_(capacity), key_to_iter_(capacity, RefHash{hash}, RefEqual{equal})
+	{
+
+	}
+
+	// 禁用拷贝构造和赋值运算符（哈希表里存的是指向链表节点的指针，不能简单复制）
+	GenericLRUCache(const GenericLRUCache& other) = delete;
+	GenericLRUCache& operator=(const GenericLRUCache& other) = delete;
+
+	// 查询：命中则移到表头并返回 value 的指针，未命中返回 nullptr
+	// 返回的指针在该 key 被淘汰或删除之前一直有效
+	template<typename Q>
+	V* get(const Q& key)
+	{
+		auto it = find_iter(key);
+		if (it == key_to_iter_.end())
+		{
+			return nullptr;
+		}
+
+		cache_list_.splice(cache_list_.begin(), cache_list_, it->second);
+		return &it->second->second;
+	}
+
+	// 只读查询：不更新访问顺序
+	template<typename Q>
+	const V* peek(const Q& key) const
+	{
+		auto it = find_iter(key);
+		return it == key_to_iter_.end() ? nullptr : &it->second->second;
+	}
+
+	template<typename Q>
+	bool contains(const Q& key) const
+	{
+		return find_iter(key) != key_to_iter_.end();
+	}
+
+	// 原地构造：key 已存在时不修改原值，只将其移到表头
+	// 返回 value 的指针，以及是否发生了插入
+	// key 可以是任何能构造 K 的类型（如 string 类型的 key 传字符串字面量），先用它查找，未命中才构造 K
+	template<typename KK, typename... Args>
+		requires constructible_from<K, KK&&>
+	pair<V*, bool> try_emplace(KK&& key, Args&&... args)
+	{
+		auto it = find_iter(key);
+		if (it != key_to_iter_.end())
+		{
+			cache_list_.splice(cache_list_.begin(), cache_list_, it->second);
+			return {&it->second->second, false};
+		}
+
+		if (capacity_ == 0)
+		{
+			return {nullptr, false};
+		}
+
+		return {emplace_new(std::forward<KK>(key), std::forward<Args>(args)...), true};
+	}
+
+	// 存入：key 已存在则以移动赋值更新值，未命中时沿用同一次查找的结果直接插入
+	template<typename KK, typename M>
+		requires constructible_from<K, KK&&>
+	pair<V*, bool> insert_or_assign(KK&& key, M&& value)
+	{
+		auto it = find_iter(key);
+		if (it != key_to_iter_.end())
+		{
+			it->second->second = std::forward<M>(value);
+			cache_list_.splice(cache_list_.begin(), cache_list_, it->second);
+			return {&it->second->second, false};
+		}
+
+		if (capacity_ == 0)
+		{
+			return {nullptr, false};
+		}
+
+		return {emplace_new(std::forward<KK>(key), std::forward<M>(value)), true};
+	}
+
+	// 删除
+	template<typename Q>
+	bool erase(const Q& key)
+	{
+		auto it = find_iter(key);
+		if (it == key_to_iter_.end())
+		{
+			return false;
+		}
+
+		ListIter node = it->second;
+		key_to_iter_.erase(it);
+		cache_list_.erase(node);
+		return true;
+	}
+
+	size_t size() const noexcept
+	{
+		return cache_list_.size();
+	}
+
+	size_t capacity() const noexcept
+	{
+		return capacity_;
+	}
+};
+
+// 演示代码：被其他文件 #include 时（如 LRUCache_benchmark.cpp），定义 LRU_CACHE_NO_DEMO 跳过
+#ifndef LRU_CACHE_NO_DEMO
+
+// 演示用的大块数据：统计拷贝次数，并且禁止隐式拷贝
+struct Blob
+{
+	static inline int copies = 0;
+	vector<char> bytes;
+
+	explicit Blob(size_t n, char c) : bytes(n, c) {}
+	Blob(const Blob& other) : bytes(other.bytes) { copies++; }
+	Blob(Blob&&) noexcept = default;
+	Blob& operator=(Blob&&) noexcept = default;
+};
+
+int main()
+{
+	// 1. 原版语义：int -> int
+	GenericLRUCache<int, int> lru(2);
+	lru.insert_or_assign(1, 1);
+	lru.insert_or_assign(2, 2);
+	cout << *lru.get(1) << "\n";						// 1
+	lru.insert_or_assign(3, 3);							// 淘汰 key 2
+	cout << (lru.get(2) ? "hit" : "miss") << "\n";		// miss
+
+	// 2. string key + 大块 value：用 string_view 查找，命中时不拷贝
+	GenericLRUCache<string, Blob, StringHash, equal_to<>> blobs(16);
+	blobs.try_emplace("user:42", 4096, 'a');
+	blobs.try_emplace("user:43", 8192, 'b');
+
+	string_view key = "user:42";
+	if (Blob* b = blobs.get(key))
+	{
+		cout << "user:42 -> " << b->bytes.size() << " bytes\n";
+	}
+	cout << "拷贝次数: " << Blob::copies << "\n";		// 0
+
+	// 3. 只能移动的 value
+	GenericLRUCache<string, unique_ptr<string>, StringHash, equal_to<>> owners(1);
+	owners.insert_or_assign("a", make_unique<string>("first"));
+	owners.insert_or_assign("b", make_unique<string>("second"));	// 淘汰 "a"
+	cout << (owners.contains("a") ? "a 仍在缓存" : "a 已淘汰") << ", b -> " << **owners.get("b") << "\n";
+
+	return 0;
+}
+
+#endif // LRU_CACHE_NO_DEMO
@@ -0,0 +1,258 @@
+#include <iostream>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <future>
+#include <thread>
+#include <vector>
+#include <optional>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+/*
+ * LeetCode 146: LRU 缓存 —— 自动加载 + 并发未命中合并 (single-flight)
+ * 热点 key 未命中时，所有并发调用者都会各自去后端加载一次，形成“缓存击穿”
+ * 做法：get_or_load(key, loader)
+ * (1) 第一个未命中的线程成为“领头者”，登记一个进行中的 promise，在锁外调用 loader
+ * (2) 之后未命中同一 key 的线程拿到同一个 shared_future 等待，不再重复加载
+ * (3) 加载成功：结果写入缓存，并通过 promise.set_value() 交给所有等待者
+ *     加载失败：通过 promise.set_exception() 把异常转交给所有等待者，失败结果不进入缓存
+ * promise / future 的用法与 programs/threadApplications/simpleAsync.cpp 相同
+ */
+
+template<typename K, typename V>
+class LoadingLRUCache
+{
+	using CacheNode = pair<K, V>;
+
+	// 进行中的加载：id 用于判断这次加载是否已被期间的 put 覆盖
+	struct InFlight
+	{
+		shared_future<V> future;
+		uint64_t id;
+	};
+
+	size_t capacity_;
+	mutex mtx_;
+
+	// 双向链表
+	list<CacheNode> cache_list_;
+
+	// 哈希表
+	unordered_map<K, typename list<CacheNode>::iterator> key_to_iter_;
+
+	// 进行中的加载
+	unordered_map<K, InFlight> in_flight_;
+	uint64_t next_load_id_ = 0;
+
+	// 以下 *_locked 函数要求调用方已持有 mtx_
+	optional<V> get_locked(const K& key)
+	{
+		auto it = key_to_iter_.find(key);
+		if (it == key_to_iter_.end())
+		{
+			return nullopt;
+		}
+
+		cache_list_.splice(cache_list_.begin(), cache_list_, it->second);
+		return it->second->second;
+	}
+
+	void put_locked(const K& key, const V& value)
+	{
+		auto it = key_to_iter_.find(key);
+		if (it != key_to_iter_.end())
+		{
+			it->second->second = value;
+			cache_list_.splice(cache_list_.begin(), cache_list_, it->second);
+			return;
+		}
+
+		if (capacity_ == 0)
+		{
+			return;
+		}
+
+		// 先插入新条目，成功后再淘汰：哈希表插入抛出异常时撤销链表节点，缓存保持原样
+		cache_list_.emplace_front(key, value);
+		try
+		{
+			key_to_iter_.emplace(key, cache_list_.begin());
+		}
+		catch (...)
+		{
+			cache_list_.pop_front();
+			throw;
+		}
+
+		if (cache_list_.size() > capacity_)
+		{
+			key_to_iter_.erase(cache_list_.back().first);
+			cache_list_.pop_back();
+		}
+	}
+
+public:
+	explicit LoadingLRUCache(size_t capacity) : capacity_(capacity)
+	{
+
+	}
+
+	// 禁用拷贝构造和赋值运算符
+	LoadingLRUCache(const LoadingLRUCache& other) = delete;
+	LoadingLRUCache& operator=(const LoadingLRUCache& other) = delete;
+
+	// 查询：不触发加载
+	optional<V> get(const K& key)
+	{
+		lock_guard<mutex> lock(mtx_);
+		return get_locked(key);
+	}
+
+	// 存入：若该 key 正在加载，加载结果不再写回缓存（以本次 put 为准）
+	void put(const K& key, const V& value)
+	{
+		lock_guard<mutex> lock(mtx_);
+		in_flight_.erase(key);
+		put_locked(key, value);
+	}
+
+	// 查询，未命中则调用 loader(key) 加载；同一 key 的并发未命中只加载一次
+	// loader 抛出的异常会传给所有等待该次加载的调用者
+	template<typename Loader>
+	V get_or_load(const K& key, Loader&& loader)
+	{
+		unique_lock<mutex> lock(mtx_);
+
+		if (optional<V> hit = get_locked(key))
+		{
+			return std::move(*hit);
+		}
+
+		// 已有线程在加载：释放锁后等待它的结果
+		auto flight = in_flight_.find(key);
+		if (flight != in_flight_.end())
+		{
+			shared_future<V> future = flight->second.future;
+			lock.unlock();
+			return future.get();
+		}
+
+		// 成为领头者：登记进行中的加载，在锁外执行 loader，避免阻塞其他 key
+		promise<V> result_promise;
+		uint64_t id = next_load_id_++;
+		in_flight_.emplace(key, InFlight{result_promise.get_future().share(), id});
+		lock.unlock();
+
+		// try 只包住 loader：此时一定没有持有锁，异常处理中可以放心重新加锁
+		optional<V> value;
+		try
+		{
+			value.emplace(loader(key));
+		}
+		catch (...)
+		{
+			lock.lock();
+			auto mine = in_flight_.find(key);
+			if (mine != in_flight_.end() && mine->second.id == id)
+			{
+				in_flight_.erase(mine);
+			}
+			lock.unlock();
+
+			result_promise.set_exception(current_exception());
+			throw;
+		}
+
+		lock.lock();
+		// 写入缓存与撤销登记在同一把锁内完成，后来者要么命中缓存，要么等待 future
+		auto mine = in_flight_.find(key);
+		if (mine != in_flight_.end() && mine->second.id == id)
+		{
+			in_flight_.erase(mine);
+			try
+			{
+				put_locked(key, *value);
+			}
+			catch (...)
+			{
+				// 写入缓存失败（如内存不足）只是少缓存一条，加载结果照常交给等待者和调用方
+			}
+		}
+		lock.unlock();
+
+		result_promise.set_value(*value);
+		return std::move(*value);
+	}
+
+	size_t size()
+	{
+		lock_guard<mutex> lock(mtx_);
+		return cache_list_.size();
+	}
+};
+
+int main()
+{
+	LoadingLRUCache<string, string> cache(100);
+	atomic<int> backend_calls{0};
+
+	// 模拟耗时 200ms 的后端查询
+	auto slow_backend = [&backend_calls](const string& key)
+	{
+		backend_calls++;
+		this_thread::sleep_for(chrono::milliseconds(200));
+		return "value_of_" + key;
+	};
+
+	// 1. 16 个线程同时未命中同一个热点 key
+	vector<thread> threads;
+	for (int i = 0; i < 16; i++)
+	{
+		threads.emplace_back([&cache, &slow_backend]
+		{
+			cache.get_or_load("hot_key", slow_backend);
+		});
+	}
+	for (auto& t : threads)
+	{
+		t.join();
+	}
+	cout << "16 个并发未命中，后端调用次数: " << backend_calls << "\n";		// 1
+	cout << "缓存中的值: " << *cache.get("hot_key") << "\n";
+
+	// 2. 加载失败：异常传给所有等待者，且不缓存失败结果
+	auto failing_backend = [](const string&) -> string
+	{
+		this_thread::sleep_for(chrono::milliseconds(50));
+		throw runtime_error("backend timeout");
+	};
+
+	threads.clear();
+	atomic<int> failures{0};
+	for (int i = 0; i < 4; i++)
+	{
+		threads.emplace_back([&cache, &failing_backend, &failures]
+		{
+			try
+			{
+				cache.get_or_load("broken_key", failing_backend);
+			}
+			catch (const runtime_error&)
+			{
+				failures++;
+			}
+		});
+	}
+	for (auto& t : threads)
+	{
+		t.join();
+	}
+	cout << "加载失败的调用者: " << failures << "，broken_key 是否被缓存: " << (cache.get("broken_key") ? "是" : "否") << "\n";
+
+	return 0;
+}
@@ -0,0 +1,700 @@
+#include <iostream>
+#include <list>
+#include <deque>
+#include <vector>
+#include <unordered_map>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+
+#include "LRUCache_zipf.h"
+
+using namespace std;
+
+/*
+ * LeetCode 146: LRU 缓存 —— 可插拔的淘汰 / 准入策略
+ * 纯 LRU 的问题：一次顺序扫描会把热点数据全部挤出缓存，命中率骤降
+ * 做法：缓存本身只负责存取 key -> value，由策略类决定“谁留下、谁被淘汰”
+ * 提供的策略：
+ * (1) LRUPolicy      : 原版 LRU，作为对照
+ * (2) WTinyLFUPolicy : 1% 的窗口 LRU + Count-Min Sketch 频率过滤 + 分段 LRU 主区
+ * (3) S3FIFOPolicy   : 小 FIFO + 主 FIFO + 幽灵队列，只访问一次的数据很快被清出
+ * (4) ARCPolicy      : 自适应替换缓存，在“最近”与“频繁”两个 LRU 之间动态分配容量
+ *
+ * 策略接口（均以 key 为单位，不关心 value）：
+ *   void on_hit(int key)                          : 命中
+ *   void on_miss(int key)                         : 未命中（用于频率统计）
+ *   bool on_insert(int key, vector<int>& evicted) : 插入新 key，被淘汰的 key 写入 evicted；返回 false 表示拒绝准入
+ */
+
+static uint64_t mix64(uint64_t h) noexcept
+{
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+	return h;
+}
+
+// 缓存本体：存储与策略分离
+template<typename Policy>
+class PolicyCache
+{
+	Policy policy_;
+	unordered_map<int, int> store_;
+	vector<int> evicted_;
+
+public:
+	explicit PolicyCache(size_t capacity) : policy_(capacity)
+	{
+		store_.reserve(capacity);
+	}
+
+	// 禁用拷贝构造和赋值运算符
+	PolicyCache(const PolicyCache& other) = delete;
+	PolicyCache& operator=(const PolicyCache& other) = delete;
+
+	// 查询：查不到返回 -1
+	int get(int key)
+	{
+		auto it = store_.find(key);
+		if (it == store_.end())
+		{
+			policy_.on_miss(key);
+			return -1;
+		}
+
+		policy_.on_hit(key);
+		return it->second;
+	}
+
+	// 存入：已存在则更新值；否则交给策略决定是否准入、淘汰谁
+	void put(int key, int value)
+	{
+		auto it = store_.find(key);
+		if (it != store_.end())
+		{
+			it->second = value;
+			policy_.on_hit(key);
+			return;
+		}
+
+		evicted_.clear();
+		bool admitted = policy_.on_insert(key, evicted_);
+		for (int k : evicted_)
+		{
+			store_.erase(k);
+		}
+		if (admitted)
+		{
+			store_.emplace(key, value);
+		}
+	}
+
+	size_t size() const noexcept
+	{
+		return store_.size();
+	}
+};
+
+// ---------------------------------------------------------------------------
+// 策略 1：LRU
+// ---------------------------------------------------------------------------
+class LRUPolicy
+{
+	size_t capacity_;
+	list<int> order_;
+	unordered_map<int, list<int>::iterator> key_to_iter_;
+
+public:
+	explicit LRUPolicy(size_t capacity) : capacity_(capacity) {}
+
+	void on_hit(int key)
+	{
+		order_.splice(order_.begin(), order_, key_to_iter_[key]);
+	}
+
+	void on_miss(int) {}
+
+	bool on_insert(int key, vector<int>& evicted)
+	{
+		if (capacity_ == 0)
+		{
+			return false;
+		}
+		if (order_.size() >= capacity_)
+		{
+			evicted.push_back(order_.back());
+			key_to_iter_.erase(order_.back());
+			order_.pop_back();
+		}
+		order_.push_front(key);
+		key_to_iter_[key] = order_.begin();
+		return true;
+	}
+};
+
+// ---------------------------------------------------------------------------
+// 策略 2：W-TinyLFU
+// ---------------------------------------------------------------------------
+
+// Count-Min Sketch：4 行计数器取最小值估计访问频率
+// 计数器上限 15（相当于 4 bit），累计增量达到 10 倍容量后全部减半，让旧的热度逐渐衰减
+class CountMinSketch
+{
+	static constexpr int DEPTH = 4;
+	static constexpr uint8_t MAX_COUNT = 15;
+
+	vector<uint8_t> table_;
+	size_t width_mask_;
+	size_t additions_ = 0;
+	size_t sample_size_;
+
+	size_t index(uint64_t h, int row) const noexcept
+	{
+		// 双重哈希：用一个 64 位哈希派生出 DEPTH 个下标
+		uint64_t combined = h + row * ((h >> 32) | 1);
+		return row * (width_mask_ + 1) + (combined & width_mask_);
+	}
+
+public:
+	explicit CountMinSketch(size_t capacity)
+	{
+		size_t width = 16;
+		while (width < capacity * 4)
+		{
+			width <<= 1;
+		}
+		width_mask_ = width - 1;
+		table_.assign(width * DEPTH, 0);
+		sample_size_ = max<size_t>(capacity, 1) * 10;
+	}
+
+	void increment(int key)
+	{
+		uint64_t h = mix64(static_cast<uint32_t>(key));
+		for (int row = 0; row < DEPTH; row++)
+		{
+			uint8_t& c = table_[index(h, row)];
+			if (c < MAX_COUNT)
+			{
+				c++;
+			}
+		}
+
+		if (++additions_ >= sample_size_)
+		{
+			for (auto& c : table_)
+			{
+				c >>= 1;
+			}
+			additions_ /= 2;
+		}
+	}
+
+	uint8_t estimate(int key) const
+	{
+		uint64_t h = mix64(static_cast<uint32_t>(key));
+		uint8_t result = MAX_COUNT;
+		for (int row = 0; row < DEPTH; row++)
+		{
+			result = min(result, table_[index(h, row)]);
+		}
+		return result;
+	}
+};
+
+// 新数据先进入 1% 大小的窗口 LRU；窗口溢出时，被挤出的“候选者”与主区的“受害者”比较频率，
+// 频率高者留在缓存中。主区是分段 LRU：试用区 (20%) + 保护区 (80%)
+class WTinyLFUPolicy
+{
+	enum class Segment { Window, Probation, Protected };
+
+	struct Entry
+	{
+		Segment segment;
+		list<int>::iterator iter;
+	};
+
+	size_t window_capacity_;
+	size_t main_capacity_;
+	size_t protected_capacity_;
+
+	list<int> window_;
+	list<int> probation_;
+	list<int> protected_;
+	unordered_map<int, Entry> entries_;
+	CountMinSketch sketch_;
+
+	list<int>& segment_list(Segment s)
+	{
+		switch (s)
+		{
+		case Segment::Window:
+			return window_;
+		case Segment::Probation:
+			return probation_;
+		default:
+			return protected_;
+		}
+	}
+
+	// 把 key 移到目标分段的表头
+	void move_to(Entry& e, Segment target)
+	{
+		list<int>& dst = segment_list(target);
+		dst.splice(dst.begin(), segment_list(e.segment), e.iter);
+		e.segment = target;
+		e.iter = dst.begin();
+	}
+
+	void evict(int key, list<int>& from, vector<int>& evicted)
+	{
+		from.erase(entries_[key].iter);
+		entries_.erase(key);
+		evicted.push_back(key);
+	}
+
+public:
+	explicit WTinyLFUPolicy(size_t capacity) : sketch_(capacity)
+	{
+		// 容量为 0 时窗口也为 0：与其他策略一致，拒绝所有插入
+		window_capacity_ = capacity == 0 ? 0 : max<size_t>(1, capacity / 100);
+		main_capacity_ = capacity > window_capacity_ ? capacity - window_capacity_ : 0;
+		protected_capacity_ = main_capacity_ * 8 / 10;
+	}
+
+	void on_hit(int key)
+	{
+		sketch_.increment(key);
+
+		Entry& e = entries_[key];
+		switch (e.segment)
+		{
+		case Segment::Window:
+			move_to(e, Segment::Window);
+			break;
+		case Segment::Protected:
+			move_to(e, Segment::Protected);
+			break;
+		case Segment::Probation:
+			// 试用区再次命中，晋升到保护区；保护区溢出则把最旧的降级回试用区
+			move_to(e, Segment::Protected);
+			if (protected_.size() > protected_capacity_)
+			{
+				int demoted = protected_.back();
+				move_to(entries_[demoted], Segment::Probation);
+			}
+			break;
+		}
+	}
+
+	void on_miss(int key)
+	{
+		sketch_.increment(key);
+	}
+
+	bool on_insert(int key, vector<int>& evicted)
+	{
+		if (window_capacity_ + main_capacity_ == 0)
+		{
+			return false;
+		}
+
+		window_.push_front(key);
+		entries_[key] = Entry{Segment::Window, window_.begin()};
+		if (window_.size() <= window_capacity_)
+		{
+			return true;
+		}
+
+		// 窗口溢出：候选者进入主区，或与主区受害者比较频率
+		int candidate = window_.back();
+		if (probation_.size() + protected_.size() < main_capacity_)
+		{
+			move_to(entries_[candidate], Segment::Probation);
+			return true;
+		}
+		if (main_capacity_ == 0)
+		{
+			evict(candidate, window_, evicted);
+			return true;
+		}
+
+		list<int>& victim_list = probation_.empty() ? protected_ : probation_;
+		int victim = victim_list.back();
+		if (sketch_.estimate(candidate) > sketch_.estimate(victim))
+		{
+			evict(victim, victim_list, evicted);
+			move_to(entries_[candidate], Segment::Probation);
+		}
+		else
+		{
+			evict(candidate, window_, evicted);
+		}
+		return true;
+	}
+};
+
+// ---------------------------------------------------------------------------
+// 策略 3：S3-FIFO
+// ---------------------------------------------------------------------------
+
+// 新数据进入小 FIFO (10%)；从小 FIFO 淘汰时，被访问过的数据转入主 FIFO，其余只在幽灵队列留下 key
+// 幽灵队列中的 key 再次插入时直接进入主 FIFO。主 FIFO 淘汰时，访问计数大于 0 的数据计数减一后重新入队
+class S3FIFOPolicy
+{
+	struct Entry
+	{
+		bool in_main;
+		uint8_t freq;
+	};
+
+	static constexpr uint8_t MAX_FREQ = 3;
+
+	size_t capacity_;
+	size_t small_capacity_;
+
+	deque<int> small_;
+	deque<int> main_;
+	unordered_map<int, Entry> entries_;
+
+	// 幽灵队列：只记录 key；deque 中的过期项用插入序号惰性识别
+	deque<pair<int, uint64_t>> ghost_queue_;
+	unordered_map<int, uint64_t> ghost_;
+	uint64_t ghost_seq_ = 0;
+
+	void add_ghost(int key)
+	{
+		ghost_[key] = ++ghost_seq_;
+		ghost_queue_.emplace_back(key, ghost_seq_);
+
+		size_t ghost_capacity = capacity_ - small_capacity_;
+		while (ghost_.size() > ghost_capacity && !ghost_queue_.empty())
+		{
+			auto [k, seq] = ghost_queue_.front();
+			ghost_queue_.pop_front();
+			auto it = ghost_.find(k);
+			if (it != ghost_.end() && it->second == seq)
+			{
+				ghost_.erase(it);
+			}
+		}
+	}
+
+	void evict_small(vector<int>& evicted)
+	{
+		while (!small_.empty())
+		{
+			int key = small_.front();
+			small_.pop_front();
+
+			Entry& e = entries_[key];
+			if (e.freq > 0)
+			{
+				e.in_main = true;
+				e.freq = 0;
+				main_.push_back(key);
+				if (main_.size() > capacity_ - small_capacity_)
+				{
+					evict_main(evicted);
+					return;
+				}
+			}
+			else
+			{
+				entries_.erase(key);
+				add_ghost(key);
+				evicted.push_back(key);
+				return;
+			}
+		}
+	}
+
+	void evict_main(vector<int>& evicted)
+	{
+		while (!main_.empty())
+		{
+			int key = main_.front();
+			main_.pop_front();
+
+			Entry& e = entries_[key];
+			if (e.freq > 0)
+			{
+				e.freq--;
+				main_.push_back(key);
+			}
+			else
+			{
+				entries_.erase(key);
+				evicted.push_back(key);
+				return;
+			}
+		}
+	}
+
+public:
+	explicit S3FIFOPolicy(size_t capacity) : capacity_(capacity)
+	{
+		small_capacity_ = max<size_t>(1, capacity / 10);
+		if (small_capacity_ >= capacity_)
+		{
+			small_capacity_ = capacity_ > 1 ? capacity_ - 1 : capacity_;
+		}
+	}
+
+	void on_hit(int key)
+	{
+		Entry& e = entries_[key];
+		if (e.freq < MAX_FREQ)
+		{
+			e.freq++;
+		}
+	}
+
+	void on_miss(int) {}
+
+	bool on_insert(int key, vector<int>& evicted)
+	{
+		if (capacity_ == 0)
+		{
+			return false;
+		}
+
+		while (entries_.size() >= capacity_)
+		{
+			if (small_.size() >= small_capacity_ || main_.empty())
+			{
+				evict_small(evicted);
+			}
+			else
+			{
+				evict_main(evicted);
+			}
+		}
+
+		auto ghost = ghost_.find(key);
+		if (ghost != ghost_.end() && capacity_ > small_capacity_)
+		{
+			ghost_.erase(ghost);
+			entries_[key] = Entry{true, 0};
+			main_.push_back(key);
+		}
+		else
+		{
+			entries_[key] = Entry{false, 0};
+			small_.push_back(key);
+		}
+		return true;
+	}
+};
+
+// ---------------------------------------------------------------------------
+// 策略 4：ARC
+// ---------------------------------------------------------------------------
+
+// T1: 只访问过一次的数据；T2: 访问过多次的数据；B1/B2: 分别从 T1/T2 淘汰的幽灵 key
+// 命中 B1 说明“最近”区太小，调大目标值 p；命中 B2 则调小 p
+class ARCPolicy
+{
+	enum class Which { T1, T2, B1, B2 };
+
+	struct Entry
+	{
+		Which which;
+		list<int>::iterator iter;
+	};
+
+	size_t capacity_;
+	double p_ = 0;
+
+	list<int> t1_, t2_, b1_, b2_;
+	unordered_map<int, Entry> entries_;
+
+	list<int>& list_of(Which w)
+	{
+		switch (w)
+		{
+		case Which::T1:
+			return t1_;
+		case Which::T2:
+			return t2_;
+		case Which::B1:
+			return b1_;
+		default:
+			return b2_;
+		}
+	}
+
+	void move_to_front(int key, Which target)
+	{
+		Entry& e = entries_[key];
+		list<int>& dst = list_of(target);
+		dst.splice(dst.begin(), list_of(e.which), e.iter);
+		e.which = target;
+		e.iter = dst.begin();
+	}
+
+	void drop_lru(list<int>& ghost)
+	{
+		entries_.erase(ghost.back());
+		ghost.pop_back();
+	}
+
+	// 从 T1 或 T2 淘汰一个数据，key 转入对应的幽灵队列
+	void replace(bool hit_in_b2, vector<int>& evicted)
+	{
+		if (!t1_.empty() && (t1_.size() > p_ || (hit_in_b2 && t1_.size() == static_cast<size_t>(p_))))
+		{
+			int victim = t1_.back();
+			move_to_front(victim, Which::B1);
+			evicted.push_back(victim);
+		}
+		else if (!t2_.empty())
+		{
+			int victim = t2_.back();
+			move_to_front(victim, Which::B2);
+			evicted.push_back(victim);
+		}
+	}
+
+public:
+	explicit ARCPolicy(size_t capacity) : capacity_(capacity) {}
+
+	void on_hit(int key)
+	{
+		move_to_front(key, Which::T2);
+	}
+
+	void on_miss(int) {}
+
+	bool on_insert(int key, vector<int>& evicted)
+	{
+		if (capacity_ == 0)
+		{
+			return false;
+		}
+
+		double c = static_cast<double>(capacity_);
+		bool cache_full = t1_.size() + t2_.size() >= capacity_;
+		auto it = entries_.find(key);
+
+		if (it != entries_.end() && it->second.which == Which::B1)
+		{
+			p_ = min(c, p_ + max(static_cast<double>(b2_.size()) / b1_.size(), 1.0));
+			if (cache_full)
+			{
+				replace(false, evicted);
+			}
+			move_to_front(key, Which::T2);
+			return true;
+		}
+
+		if (it != entries_.end() && it->second.which == Which::B2)
+		{
+			p_ = max(0.0, p_ - max(static_cast<double>(b1_.size()) / b2_.size(), 1.0));
+			if (cache_full)
+			{
+				replace(true, evicted);
+			}
+			move_to_front(key, Which::T2);
+			return true;
+		}
+
+		// 完全未见过的 key
+		size_t l1 = t1_.size() + b1_.size();
+		size_t total = l1 + t2_.size() + b2_.size();
+		if (l1 >= capacity_)
+		{
+			if (t1_.size() < capacity_)
+			{
+				drop_lru(b1_);
+				if (cache_full)
+				{
+					replace(false, evicted);
+				}
+			}
+			else
+			{
+				int victim = t1_.back();
+				entries_.erase(victim);
+				t1_.pop_back();
+				evicted.push_back(victim);
+			}
+		}
+		else if (total >= capacity_)
+		{
+			if (total >= 2 * capacity_)
+			{
+				drop_lru(b2_);
+			}
+			if (cache_full)
+			{
+				replace(false, evicted);
+			}
+		}
+
+		t1_.push_front(key);
+		entries_[key] = Entry{Which::T1, t1_.begin()};
+		return true;
+	}
+};
+
+// 演示代码：被其他文件 #include 时（如 LRUCache_benchmark.cpp），定义 LRU_CACHE_NO_DEMO 跳过
+#ifndef LRU_CACHE_NO_DEMO
+
+// ---------------------------------------------------------------------------
+// 演示：Zipf 热点负载中周期性插入大范围顺序扫描
+// ---------------------------------------------------------------------------
+template<typename Policy>
+double hit_ratio(const vector<int>& trace, size_t capacity)
+{
+	PolicyCache<Policy> cache(capacity);
+	size_t hits = 0;
+	for (int key : trace)
+	{
+		if (cache.get(key) != -1)
+		{
+			hits++;
+		}
+		else
+		{
+			cache.put(key, key);
+		}
+	}
+	return static_cast<double>(hits) / trace.size();
+}
+
+int main()
+{
+	const size_t capacity = 1000;
+	const size_t hot_keys = 10000;
+	ZipfGenerator zipf(hot_keys, 0.9);
+	mt19937_64 gen(7);
+
+	// 每 20000 次热点访问后，插入一次 5000 个从未出现过的 key 的顺序扫描
+	vector<int> trace;
+	int scan_base = 1000000;
+	for (int round = 0; round < 20; round++)
+	{
+		for (int i = 0; i < 20000; i++)
+		{
+			trace.push_back(zipf(gen));
+		}
+		for (int i = 0; i < 5000; i++)
+		{
+			trace.push_back(scan_base++);
+		}
+	}
+
+	cout << "容量 " << capacity << "，访问序列长度 " << trace.size() << "\n";
+	cout << "LRU       命中率: " << hit_ratio<LRUPolicy>(trace, capacity) << "\n";
+	cout << "W-TinyLFU 命中率: " << hit_ratio<WTinyLFUPolicy>(trace, capacity) << "\n";
+	cout << "S3-FIFO   命中率: " << hit_ratio<S3FIFOPolicy>(trace, capacity) << "\n";
+	cout << "ARC       命中率: " << hit_ratio<ARCPolicy>(trace, capacity) << "\n";
+
+	return 0;
+}
+
+#endif // LRU_CACHE_NO_DEMO
@@ -0,0 +1,772 @@
+// LRUCache 本机缓存服务（sidecar）与压测客户端 (Linux)
+// 编译：g++ -std=c++17 -O2 -pthread LRUCache_server.cpp -o lru_server
+// 用法：./lru_server serve [--port 11311] [--capacity N]
+//       ./lru_server bench [--port 11311] [--conns N] [--depth N] [--ops N] [--keys N]
+//       ./lru_server                         —— 同一进程内起服务端和客户端跑一遍
+//
+// 协议（文本，每行一个请求，可流水线连续发送，响应按请求顺序返回）：
+//   GET <key>            -> <value>\n          （未命中为 -1）
+//   SET <key> <value>    -> OK\n
+//   MGET <key> <key> ... -> <value> <value> ...\n
+//   其他（未知命令、参数不是整数、参数后有多余内容）-> ERR\n
+#define LRU_CACHE_NO_DEMO
+#include "LRUCache.cpp"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <charconv>
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+
+#include <arpa/inet.h>		// htons / htonl
+#include <netinet/in.h>
+#include <netinet/tcp.h>	// TCP_NODELAY
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>		// writev
+#include <unistd.h>
+
+using namespace std;
+
+/*
+ * 让非 C++ 进程也能共用一个 LRUCache：单 reactor 的 epoll 服务端，只监听 127.0.0.1
+ * (1) 单线程事件循环独占 LRUCache，不需要任何锁
+ * (2) 一次可读事件里把能读到的数据全部读完，解析出所有完整的请求行，响应拼在同一批里
+ *     这一批作为一个 chunk 挂到连接的输出队列，再用一次 writev 把队列中所有 chunk 写出
+ *     客户端流水线发送 N 个请求时，服务端只需 1 次 read + 1 次 writev，而不是 N 次 write
+ * (3) 写不完（EAGAIN）时才关注 EPOLLOUT，写空后取消，避免空转
+ * (4) 背压：待发送的响应超过高水位时暂停读取（取消 EPOLLIN），写到低水位以下再恢复；
+ *     单行请求超过 MAX_LINE 字节直接断开 —— 慢读或恶意的客户端不能让服务端内存无限增长
+ */
+
+class CacheServer
+{
+	static constexpr size_t MAX_LINE = 64 * 1024;				// 单个请求行的最大长度
+	static constexpr size_t OUTPUT_HIGH_WATER = 1 << 20;		// 待发送字节超过此值时暂停读取
+	static constexpr size_t OUTPUT_LOW_WATER = 256 * 1024;		// 写到此值以下恢复读取
+
+	struct Connection
+	{
+		int fd;
+		string in;					// 未解析完的输入
+		vector<string> out;			// 待发送的响应批次
+		size_t out_offset = 0;		// out[0] 已发送的字节数
+		size_t out_bytes = 0;		// 待发送的总字节数
+		bool write_blocked = false;	// 上次写入遇到 EAGAIN，等待 EPOLLOUT
+		bool reading = true;		// 未被背压暂停
+		bool closing = false;		// 对端已关闭写方向：发完剩余响应后关闭
+		uint32_t events = EPOLLIN;	// 当前注册的 epoll 事件
+	};
+
+	LRUCache cache_;
+	int listen_fd_ = -1;
+	int epoll_fd_ = -1;
+	int wake_fd_ = -1;				// stop() 通过 eventfd 唤醒事件循环
+	uint16_t port_ = 0;
+	atomic<bool> stopping_{false};
+	unordered_map<int, unique_ptr<Connection>> conns_;
+	uint64_t requests_ = 0;
+	vector<int> mget_keys_;			// MGET 解析出的 key，复用以免每行分配
+
+	// 解析一个以空格分隔的整数：数字后必须紧跟空格或行尾，"1abc" 不算合法参数
+	static bool parse_int(const char*& p, const char* end, int& value)
+	{
+		while (p < end && *p == ' ')
+		{
+			p++;
+		}
+		auto [next, ec] = from_chars(p, end, value);
+		if (ec != errc() || (next < end && *next != ' '))
+		{
+			return false;
+		}
+		p = next;
+		return true;
+	}
+
+	// 最后一个参数之后只允许有空格
+	static bool at_line_end(const char* p, const char* end)
+	{
+		while (p < end && *p == ' ')
+		{
+			p++;
+		}
+		return p == end;
+	}
+
+	static void append_int(string& out, int value)
+	{
+		char buf[16];
+		auto [end, ec] = to_chars(buf, buf + sizeof(buf), value);
+		out.append(buf, end);
+	}
+
+	// 处理一行请求，响应追加到 out
+	void handle_line(const char* p, const char* end, string& out)
+	{
+		requests_++;
+		int key = 0, value = 0;
+
+		if (end - p >= 4 && memcmp(p, "GET ", 4) == 0)
+		{
+			p += 4;
+			if (parse_int(p, end, key) && at_line_end(p, end))
+			{
+				append_int(out, cache_.get(key));
+				out += '\n';
+				return;
+			}
+		}
+		else if (end - p >= 4 && memcmp(p, "SET ", 4) == 0)
+		{
+			p += 4;
+			if (parse_int(p, end, key) && parse_int(p, end, value) && at_line_end(p, end))
+			{
+				cache_.put(key, value);
+				out += "OK\n";
+				return;
+			}
+		}
+		else if (end - p >= 5 && memcmp(p, "MGET ", 5) == 0)
+		{
+			p += 5;
+			// 先解析全部 key：任何一个不合法就整行回复 ERR，不返回只覆盖部分 key 的结果
+			mget_keys_.clear();
+			while (!at_line_end(p, end) && parse_int(p, end, key))
+			{
+				mget_keys_.push_back(key);
+			}
+			if (!mget_keys_.empty() && at_line_end(p, end))
+			{
+				for (int k : mget_keys_)
+				{
+					append_int(out, cache_.get(k));
+					out += ' ';
+				}
+				out.back() = '\n';
+				return;
+			}
+		}
+
+		out += "ERR\n";
+	}
+
+	// 构造过程中出错：关闭已经打开的 fd 后抛出（构造函数抛异常时析构函数不会执行）
+	[[noreturn]] void fail_setup(const char* what)
+	{
+		string err = strerror(errno);
+		for (int fd : {wake_fd_, epoll_fd_, listen_fd_})
+		{
+			if (fd >= 0)
+			{
+				::close(fd);
+			}
+		}
+		throw runtime_error(string(what) + ": " + err);
+	}
+
+	// 按连接状态更新关注的事件：背压或对端关闭时不读，写阻塞时等 EPOLLOUT
+	void update_events(Connection& c)
+	{
+		if (c.out_bytes >= OUTPUT_HIGH_WATER)
+		{
+			c.reading = false;
+		}
+		else if (c.out_bytes <= OUTPUT_LOW_WATER)
+		{
+			c.reading = true;
+		}
+
+		uint32_t events = 0;
+		if (c.reading && !c.closing)
+		{
+			events |= EPOLLIN;
+		}
+		if (c.write_blocked)
+		{
+			events |= EPOLLOUT;
+		}
+		if (events == c.events)
+		{
+			return;
+		}
+		c.events = events;
+		epoll_event ev{};
+		ev.events = events;
+		ev.data.fd = c.fd;
+		epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, c.fd, &ev);
+	}
+
+	void close_connection(int fd)
+	{
+		epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+		::close(fd);
+		conns_.erase(fd);
+	}
+
+	// 用 writev 把输出队列尽量写空；连接出错，或对端已关闭且响应已全部发出时返回 false
+	bool flush(Connection& c)
+	{
+		while (!c.out.empty())
+		{
+			iovec iov[64];
+			int n = 0;
+			for (size_t i = 0; i < c.out.size() && n < 64; i++, n++)
+			{
+				size_t skip = (i == 0) ? c.out_offset : 0;
+				iov[n].iov_base = c.out[i].data() + skip;
+				iov[n].iov_len = c.out[i].size() - skip;
+			}
+
+			ssize_t written = ::writev(c.fd, iov, n);
+			if (written < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+				if (errno == EAGAIN || errno == EWOULDBLOCK)
+				{
+					c.write_blocked = true;
+					update_events(c);
+					return true;
+				}
+				return false;
+			}
+
+			c.out_bytes -= static_cast<size_t>(written);
+
+			// 丢弃已写完的批次
+			size_t left = static_cast<size_t>(written);
+			size_t done = 0;
+			while (done < c.out.size() && left >= c.out[done].size() - (done == 0 ? c.out_offset : 0))
+			{
+				left -= c.out[done].size() - (done == 0 ? c.out_offset : 0);
+				done++;
+			}
+			c.out_offset = (done == 0 ? c.out_offset : 0) + left;
+			c.out.erase(c.out.begin(), c.out.begin() + done);
+		}
+
+		c.write_blocked = false;
+		if (c.closing)
+		{
+			return false;
+		}
+		update_events(c);
+		return true;
+	}
+
+	// 处理 c.in 中所有完整的请求行，响应作为一个批次挂到输出队列；行过长返回 false
+	bool process_lines(Connection& c)
+	{
+		string batch;
+		size_t line_start = 0;
+		for (size_t nl; (nl = c.in.find('\n', line_start)) != string::npos; line_start = nl + 1)
+		{
+			size_t line_end = nl;
+			if (line_end - line_start > MAX_LINE)
+			{
+				return false;
+			}
+			if (line_end > line_start && c.in[line_end - 1] == '\r')
+			{
+				line_end--;
+			}
+			handle_line(c.in.data() + line_start, c.in.data() + line_end, batch);
+		}
+		c.in.erase(0, line_start);
+
+		if (!batch.empty())
+		{
+			c.out_bytes += batch.size();
+			c.out.push_back(std::move(batch));
+		}
+
+		// 剩下的是不完整的一行
+		return c.in.size() <= MAX_LINE;
+	}
+
+	// 读取当前可读数据并处理其中完整的请求行，直到 EAGAIN、对端关闭或输出超过高水位
+	bool on_readable(Connection& c)
+	{
+		char buf[64 * 1024];
+		while (c.out_bytes < OUTPUT_HIGH_WATER)
+		{
+			ssize_t n = ::read(c.fd, buf, sizeof(buf));
+			if (n > 0)
+			{
+				c.in.append(buf, static_cast<size_t>(n));
+				if (!process_lines(c))
+				{
+					return false;		// 请求行过长
+				}
+				continue;
+			}
+			if (n == 0)
+			{
+				c.closing = true;		// 对端关闭：已收到请求的响应仍要发完
+				break;
+			}
+			if (errno == EAGAIN || errno == EWOULDBLOCK)
+			{
+				break;
+			}
+			if (errno != EINTR)
+			{
+				return false;
+			}
+		}
+
+		if (c.write_blocked)
+		{
+			update_events(c);		// 已在等 EPOLLOUT，不必立即再写；可能需要暂停读取
+			return true;
+		}
+		return flush(c);
+	}
+
+	void on_accept()
+	{
+		for (;;)
+		{
+			int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+			if (fd < 0)
+			{
+				return;
+			}
+
+			int one = 1;
+			setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+			epoll_event ev{};
+			ev.events = EPOLLIN;
+			ev.data.fd = fd;
+			epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev);
+			auto conn = make_unique<Connection>();
+			conn->fd = fd;
+			conns_[fd] = std::move(conn);
+		}
+	}
+
+public:
+	// port 为 0 时由内核分配，可通过 port() 取得
+	CacheServer(size_t capacity, uint16_t port) : cache_(capacity)
+	{
+		listen_fd_ = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+		int one = 1;
+		setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+		sockaddr_in addr{};
+		addr.sin_family = AF_INET;
+		addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		addr.sin_port = htons(port);
+		socklen_t len = sizeof(addr);
+		if (listen_fd_ < 0 || ::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0
+			|| ::listen(listen_fd_, SOMAXCONN) != 0
+			|| ::getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len) != 0)
+		{
+			string err = strerror(errno);
+			if (listen_fd_ >= 0)
+			{
+				::close(listen_fd_);
+			}
+			throw runtime_error("listen 127.0.0.1:" + to_string(port) + ": " + err);
+		}
+		port_ = ntohs(addr.sin_port);
+
+		epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+		if (epoll_fd_ < 0)
+		{
+			fail_setup("epoll_create1");
+		}
+		wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if (wake_fd_ < 0)
+		{
+			fail_setup("eventfd");
+		}
+
+		epoll_event ev{};
+		ev.events = EPOLLIN;
+		ev.data.fd = listen_fd_;
+		if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, listen_fd_, &ev) != 0)
+		{
+			fail_setup("epoll_ctl");
+		}
+		ev.data.fd = wake_fd_;
+		if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &ev) != 0)
+		{
+			fail_setup("epoll_ctl");
+		}
+	}
+
+	~CacheServer()
+	{
+		for (auto& [fd, conn] : conns_)
+		{
+			::close(fd);
+		}
+		::close(wake_fd_);
+		::close(epoll_fd_);
+		::close(listen_fd_);
+	}
+
+	// 禁用拷贝构造和赋值运算符
+	CacheServer(const CacheServer& other) = delete;
+	CacheServer& operator=(const CacheServer& other) = delete;
+
+	// 事件循环，直到 stop() 被调用
+	void run()
+	{
+		epoll_event events[256];
+		while (!stopping_.load(memory_order_relaxed))
+		{
+			int n = ::epoll_wait(epoll_fd_, events, 256, -1);
+			for (int i = 0; i < n; i++)
+			{
+				int fd = events[i].data.fd;
+				if (fd == listen_fd_)
+				{
+					on_accept();
+					continue;
+				}
+				if (fd == wake_fd_)
+				{
+					continue;
+				}
+
+				auto it = conns_.find(fd);
+				if (it == conns_.end())
+				{
+					continue;
+				}
+				Connection& c = *it->second;
+
+				bool ok = !(events[i].events & (EPOLLERR | EPOLLHUP)) || (events[i].events & EPOLLIN);
+				if (ok && (events[i].events & EPOLLOUT))
+				{
+					ok = flush(c);
+				}
+				if (ok && (events[i].events & EPOLLIN))
+				{
+					ok = on_readable(c);
+				}
+				if (!ok)
+				{
+					close_connection(fd);
+				}
+			}
+		}
+	}
+
+	// 可从其他线程调用
+	void stop()
+	{
+		stopping_.store(true, memory_order_relaxed);
+		uint64_t one = 1;
+		ssize_t ignored = ::write(wake_fd_, &one, sizeof(one));
+		(void)ignored;
+	}
+
+	uint16_t port() const noexcept
+	{
+		return port_;
+	}
+
+	// 仅在 run() 返回后读取
+	uint64_t requests() const noexcept
+	{
+		return requests_;
+	}
+};
+
+// ---------------------------------------------------------------------------
+// 压测客户端：每个连接一个线程，每轮流水线发送 depth 个 GET，未命中的 key 再批量 SET 回填
+// ---------------------------------------------------------------------------
+struct ClientResult
+{
+	uint64_t ops = 0;
+	uint64_t hits = 0;
+	uint64_t gets = 0;
+	string error;		// 连接失败等错误；非空时其余计数不可信
+};
+
+static int connect_loopback(uint16_t port)
+{
+	int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	sockaddr_in addr{};
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	addr.sin_port = htons(port);
+	if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+	{
+		string err = strerror(errno);
+		if (fd >= 0)
+		{
+			::close(fd);
+		}
+		throw runtime_error("connect 127.0.0.1:" + to_string(port) + ": " + err);
+	}
+	int one = 1;
+	setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+	return fd;
+}
+
+static bool send_all(int fd, const string& data)
+{
+	size_t sent = 0;
+	while (sent < data.size())
+	{
+		ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+		if (n <= 0)
+		{
+			return false;
+		}
+		sent += static_cast<size_t>(n);
+	}
+	return true;
+}
+
+// 读取 count 行响应，放入 lines（不含换行符）；buffer 保存跨批次的残余数据
+static bool read_lines(int fd, size_t count, string& buffer, vector<string>& lines)
+{
+	lines.clear();
+	char buf[64 * 1024];
+	size_t start = 0;
+	while (lines.size() < count)
+	{
+		size_t nl = buffer.find('\n', start);
+		if (nl != string::npos)
+		{
+			lines.emplace_back(buffer, start, nl - start);
+			start = nl + 1;
+			continue;
+		}
+
+		buffer.erase(0, start);
+		start = 0;
+		ssize_t n = ::recv(fd, buf, sizeof(buf), 0);
+		if (n <= 0)
+		{
+			return false;
+		}
+		buffer.append(buf, static_cast<size_t>(n));
+	}
+	buffer.erase(0, start);
+	return true;
+}
+
+ClientResult run_client(uint16_t port, int conns, size_t depth, size_t ops_per_conn, int keys)
+{
+	vector<ClientResult> results(conns);
+	vector<thread> threads;
+	for (int t = 0; t < conns; t++)
+	{
+		threads.emplace_back([&, t]
+		{
+			ClientResult& r = results[t];
+			// 异常不能逃出线程函数（否则 std::terminate），记录到本线程的结果里交给调用方
+			int fd;
+			try
+			{
+				fd = connect_loopback(port);
+			}
+			catch (const exception& e)
+			{
+				r.error = e.what();
+				return;
+			}
+
+			mt19937 gen(t);
+			uniform_int_distribution<int> dis(0, keys - 1);
+			string request, buffer;
+			vector<string> lines;
+			vector<int> batch_keys;
+
+			while (r.gets < ops_per_conn)
+			{
+				request.clear();
+				batch_keys.clear();
+				for (size_t i = 0; i < depth; i++)
+				{
+					int key = dis(gen) % (dis(gen) + 1);		// 偏向小 key 的热点分布
+					batch_keys.push_back(key);
+					request += "GET " + to_string(key) + "\n";
+				}
+				if (!send_all(fd, request) || !read_lines(fd, depth, buffer, lines))
+				{
+					break;
+				}
+
+				// 未命中的 key 一次性流水线回填
+				request.clear();
+				size_t sets = 0;
+				for (size_t i = 0; i < depth; i++)
+				{
+					if (lines[i] == "-1")
+					{
+						request += "SET " + to_string(batch_keys[i]) + " " + to_string(batch_keys[i] * 2) + "\n";
+						sets++;
+					}
+				}
+				if (sets && (!send_all(fd, request) || !read_lines(fd, sets, buffer, lines)))
+				{
+					break;
+				}
+
+				r.gets += depth;
+				r.hits += depth - sets;
+				r.ops += depth + sets;
+			}
+			::close(fd);
+		});
+	}
+	for (auto& th : threads)
+	{
+		th.join();
+	}
+
+	ClientResult total;
+	for (const auto& r : results)
+	{
+		total.ops += r.ops;
+		total.hits += r.hits;
+		total.gets += r.gets;
+		if (total.error.empty())
+		{
+			total.error = r.error;
+		}
+	}
+	return total;
+}
+
+static void report(const ClientResult& r, double seconds, int conns, size_t depth)
+{
+	cout << conns << " 个连接，流水线深度 " << depth << "：" << r.ops << " 次操作，"
+		 << static_cast<uint64_t>(r.ops / seconds) << " ops/s，命中率 " << 100.0 * r.hits / max<uint64_t>(r.gets, 1) << "%\n";
+}
+
+int main(int argc, char* argv[])
+{
+	string mode = argc > 1 ? argv[1] : "";
+	uint16_t port = 11311;
+	size_t capacity = 1 << 16;
+	int conns = 4;
+	size_t depth = 64;
+	size_t ops = 200000;
+	int keys = 1 << 18;
+
+	for (int i = (mode.empty() ? 1 : 2); i + 1 < argc; i += 2)
+	{
+		string flag = argv[i];
+		string value = argv[i + 1];
+		if (flag == "--port")
+		{
+			port = static_cast<uint16_t>(stoi(value));
+		}
+		else if (flag == "--capacity")
+		{
+			capacity = stoul(value);
+		}
+		else if (flag == "--conns")
+		{
+			conns = max(1, stoi(value));
+		}
+		else if (flag == "--depth")
+		{
+			depth = max<size_t>(1, stoul(value));
+		}
+		else if (flag == "--ops")
+		{
+			ops = stoul(value);
+		}
+		else if (flag == "--keys")
+		{
+			keys = max(1, stoi(value));
+		}
+		else
+		{
+			cerr << "未知参数: " << flag << "\n";
+			return 1;
+		}
+	}
+
+	try
+	{
+		if (mode == "serve")
+		{
+			CacheServer server(capacity, port);
+			cout << "监听 127.0.0.1:" << server.port() << "，容量 " << capacity << "\n";
+			server.run();
+			return 0;
+		}
+
+		if (mode == "bench")
+		{
+			auto start = chrono::steady_clock::now();
+			ClientResult r = run_client(port, conns, depth, ops, keys);
+			if (!r.error.empty())
+			{
+				throw runtime_error(r.error);
+			}
+			report(r, chrono::duration<double>(chrono::steady_clock::now() - start).count(), conns, depth);
+			return 0;
+		}
+
+		// 无参数：同一进程内起服务端，对比不同流水线深度
+		CacheServer server(capacity, 0);
+		thread server_thread([&server] { server.run(); });
+
+		// 客户端出错时先停掉并回收服务端线程，再把异常交给外层：joinable 的 thread 析构会 std::terminate
+		try
+		{
+			int fd = connect_loopback(server.port());
+			string buffer;
+			vector<string> lines;
+			if (send_all(fd, "SET 1 10\nSET 2 20\nMGET 1 2 3\n") && read_lines(fd, 3, buffer, lines))
+			{
+				cout << "SET/SET/MGET -> " << lines[0] << " | " << lines[1] << " | " << lines[2] << "\n";
+			}
+			else
+			{
+				cout << "SET/SET/MGET 失败\n";
+			}
+			::close(fd);
+
+			for (size_t d : {1, 16, 128})
+			{
+				auto start = chrono::steady_clock::now();
+				ClientResult r = run_client(server.port(), conns, d, ops / 4, keys);
+				if (!r.error.empty())
+				{
+					throw runtime_error(r.error);
+				}
+				report(r, chrono::duration<double>(chrono::steady_clock::now() - start).count(), conns, d);
+			}
+		}
+		catch (...)
+		{
+			server.stop();
+			server_thread.join();
+			throw;
+		}
+
+		server.stop();
+		server_thread.join();
+		cout << "服务端共处理 " << server.requests() << " 个请求\n";
+	}
+	catch (const exception& e)
+	{
+		cerr << e.what() << "\n";
+		return 1;
+	}
+
+	return 0;
+}
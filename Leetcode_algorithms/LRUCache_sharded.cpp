@@ -0,0 +1,255 @@
+#include <iostream>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+
+#include "LRUCache_zipf.h"
+
+using namespace std;
+
+/*
+ * LeetCode 146: LRU 缓存 —— 分片加锁的线程安全版本
+ * 原版 LRUCache 没有任何同步，外部只能套一把全局锁，所有线程在这把锁上排队
+ * 做法：按 key 的哈希把键空间切成 N 个分片，每个分片持有独立的锁、链表和哈希表
+ * (1) 不同分片的 get/put 互不阻塞，锁竞争降为原来的 1/N
+ * (2) 总容量按分片均分（余数分给前几个分片），所有分片容量之和严格等于全局容量
+ * 代价：淘汰只在分片内部按 LRU 进行，整体上是“近似 LRU”
+ */
+
+class ShardedLRUCache
+{
+	using CacheNode = pair<int, int>;
+
+	// 单个分片：与原版 LRUCache 的成员一一对应，再加一把锁
+	// alignas(64) 让每个分片独占缓存行，避免相邻分片的锁产生伪共享
+	struct alignas(64) Shard
+	{
+		mutex mtx_;
+		size_t capacity_ = 0;
+
+		// 双向链表
+		list<CacheNode> cache_list_;
+
+		// 哈希表
+		unordered_map<int, list<CacheNode>::iterator> key_to_iter_;
+	};
+
+	// mutex 不可移动，因此不能放进 vector，改用定长数组
+	unique_ptr<Shard[]> shards_;
+	size_t num_shards_;
+	size_t shard_mask_;
+	size_t capacity_;
+
+	// std::hash<int> 是恒等映射，低位分布差，先做一次混合再取分片下标
+	static size_t mix(int key)
+	{
+		uint64_t h = static_cast<uint32_t>(key);
+		h ^= h >> 33;
+		h *= 0xff51afd7ed558ccdULL;
+		h ^= h >> 33;
+		h *= 0xc4ceb9fe1a85ec53ULL;
+		h ^= h >> 33;
+		return static_cast<size_t>(h);
+	}
+
+	Shard& shard_for(int key)
+	{
+		return shards_[mix(key) & shard_mask_];
+	}
+
+	// 分片数取 2 的幂，便于用掩码代替取模
+	static size_t round_up_pow2(size_t n)
+	{
+		size_t p = 1;
+		while (p < n)
+		{
+			p <<= 1;
+		}
+		return p;
+	}
+
+public:
+	// num_shards 为 0 时，按 CPU 核数的 4 倍自动选择
+	explicit ShardedLRUCache(size_t capacity, size_t num_shards = 0) : capacity_(capacity)
+	{
+		if (num_shards == 0)
+		{
+			num_shards = max<size_t>(1, thread::hardware_concurrency()) * 4;
+		}
+
+		// 保证每个分片至少分到 1 个容量，否则该分片永远存不下数据
+		num_shards = round_up_pow2(num_shards);
+		while (num_shards > 1 && num_shards > capacity_)
+		{
+			num_shards >>= 1;
+		}
+
+		num_shards_ = num_shards;
+		shard_mask_ = num_shards - 1;
+		shards_ = make_unique<Shard[]>(num_shards);
+
+		// 均分容量，余数分给前几个分片
+		for (size_t i = 0; i < num_shards_; i++)
+		{
+			shards_[i].capacity_ = capacity_ / num_shards_ + (i < capacity_ % num_shards_ ? 1 : 0);
+			shards_[i].key_to_iter_.reserve(shards_[i].capacity_);
+		}
+	}
+
+	// 禁用拷贝构造和赋值运算符
+	ShardedLRUCache(const ShardedLRUCache& other) = delete;
+	ShardedLRUCache& operator=(const ShardedLRUCache& other) = delete;
+
+	// 查询：只锁 key 所在的分片
+	int get(int key)
+	{
+		Shard& shard = shard_for(key);
+		lock_guard<mutex> lock(shard.mtx_);
+
+		auto it = shard.key_to_iter_.find(key);
+		if (it == shard.key_to_iter_.end())
+		{
+			return -1;
+		}
+
+		shard.cache_list_.splice(shard.cache_list_.begin(), shard.cache_list_, it->second);
+		return it->second->second;
+	}
+
+	// 存入：只锁 key 所在的分片，淘汰也只发生在该分片内
+	void put(int key, int value)
+	{
+		Shard& shard = shard_for(key);
+		lock_guard<mutex> lock(shard.mtx_);
+
+		auto it = shard.key_to_iter_.find(key);
+		if (it != shard.key_to_iter_.end())
+		{
+			it->second->second = value;
+			shard.cache_list_.splice(shard.cache_list_.begin(), shard.cache_list_, it->second);
+			return;
+		}
+
+		if (shard.capacity_ == 0)
+		{
+			return;
+		}
+
+		// 分片已满，则删除该分片中最旧的值
+		if (shard.cache_list_.size() >= shard.capacity_)
+		{
+			// 【优化】复用被淘汰的链表节点，省去一次释放 + 一次分配
+			auto last = prev(shard.cache_list_.end());
+			shard.key_to_iter_.erase(last->first);
+			last->first = key;
+			last->second = value;
+			shard.cache_list_.splice(shard.cache_list_.begin(), shard.cache_list_, last);
+		}
+		else
+		{
+			shard.cache_list_.emplace_front(key, value);
+		}
+
+		shard.key_to_iter_[key] = shard.cache_list_.begin();
+	}
+
+	// 当前缓存的总条目数：逐个分片加锁统计，只用于观测，不在热路径上调用
+	size_t size()
+	{
+		size_t total = 0;
+		for (size_t i = 0; i < num_shards_; i++)
+		{
+			lock_guard<mutex> lock(shards_[i].mtx_);
+			total += shards_[i].cache_list_.size();
+		}
+		return total;
+	}
+
+	size_t capacity() const noexcept
+	{
+		return capacity_;
+	}
+
+	size_t shard_count() const noexcept
+	{
+		return num_shards_;
+	}
+};
+
+// 演示代码：被其他文件 #include 时（如 LRUCache_benchmark.cpp），定义 LRU_CACHE_NO_DEMO 跳过
+#ifndef LRU_CACHE_NO_DEMO
+
+// 读多写少的 Zipf 负载：未命中时回填，返回每秒操作数
+double run_zipf_workload(ShardedLRUCache& cache, const ZipfGenerator& zipf, int num_threads, int ops_per_thread)
+{
+	vector<thread> threads;
+	auto start = chrono::steady_clock::now();
+
+	for (int t = 0; t < num_threads; t++)
+	{
+		threads.emplace_back([&cache, &zipf, ops_per_thread, t]
+		{
+			mt19937_64 gen(t + 1);
+			for (int i = 0; i < ops_per_thread; i++)
+			{
+				int key = zipf(gen);
+				if (cache.get(key) == -1)
+				{
+					cache.put(key, key);
+				}
+			}
+		});
+	}
+
+	for (auto& th : threads)
+	{
+		th.join();
+	}
+
+	chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+	return num_threads * static_cast<double>(ops_per_thread) / elapsed.count();
+}
+
+int main()
+{
+	// 基本功能：与 LeetCode 146 示例一致（容量 2，单分片即为原版语义）
+	ShardedLRUCache lru(2, 1);
+	lru.put(1, 1);
+	lru.put(2, 2);
+	cout << lru.get(1) << "\n";		// 1
+	lru.put(3, 3);					// 淘汰 key 2
+	cout << lru.get(2) << "\n";		// -1
+	lru.put(4, 4);					// 淘汰 key 1
+	cout << lru.get(1) << " " << lru.get(3) << " " << lru.get(4) << "\n";	// -1 3 4
+
+	// 吞吐对比：单分片（等价于全局锁）vs 多分片
+	const size_t key_space = 1 << 16;
+	const size_t capacity = 1 << 12;
+	const int ops_per_thread = 200000;
+	ZipfGenerator zipf(key_space, 0.99);
+
+	int max_threads = static_cast<int>(max(1u, thread::hardware_concurrency()));
+	for (int threads = 1; threads <= max_threads; threads *= 2)
+	{
+		ShardedLRUCache global_lock(capacity, 1);
+		ShardedLRUCache sharded(capacity);
+
+		double base = run_zipf_workload(global_lock, zipf, threads, ops_per_thread);
+		double fast = run_zipf_workload(sharded, zipf, threads, ops_per_thread);
+
+		cout << "线程数 " << threads
+			 << " | 全局锁: " << static_cast<long long>(base) << " ops/s"
+			 << " | " << sharded.shard_count() << " 分片: " << static_cast<long long>(fast) << " ops/s\n";
+	}
+
+	return 0;
+}
+
+#endif // LRU_CACHE_NO_DEMO
@@ -0,0 +1,462 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <random>
+#include <chrono>
+#include <cstdint>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>		// O_* 常量
+#include <sys/mman.h>	// shm_open / mmap
+#include <sys/stat.h>	// fstat
+#include <sys/wait.h>	// waitpid
+#include <unistd.h>		// ftruncate / fork / close
+#include <pthread.h>	// 进程间共享的 robust mutex
+
+using namespace std;
+
+/*
+ * LeetCode 146: LRU 缓存 —— 多进程共享内存版 (POSIX)
+ * 每台机器跑多个 worker 进程，每个进程各自持有一份内容几乎相同的 LRUCache，内存浪费且每个进程都要单独预热
+ * 做法：
+ * (1) 节点数组、哈希桶和链表头尾全部放在一块 shm_open + mmap 的共享内存段中，所有 worker 映射同一段
+ * (2) 各进程映射到的地址不同，不能存指针：链表和哈希链都用节点下标 (uint32_t) 链接，NIL 表示空
+ * (3) 用 PTHREAD_PROCESS_SHARED + PTHREAD_MUTEX_ROBUST 的互斥锁保护整个结构：
+ *     持锁进程崩溃后，下一个加锁者得到 EOWNERDEAD，此时结构可能改到一半，直接清空缓存后标记锁恢复一致
+ *
+ * 段布局：ShmHeader | ShmNode[capacity] | uint32_t bucket[bucket_count]
+ * 只存 int -> int；变长 value 需要在段内另做分配器（参见 LRUCache_slab.cpp），这里不展开
+ */
+
+class SharedLRUCache
+{
+	static constexpr uint32_t NIL = UINT32_MAX;
+	static constexpr uint32_t MAGIC = 0x4C52534D;		// "MSRL"
+	static constexpr uint32_t MAX_CAPACITY = 1u << 30;	// 桶数取 >= 2 * capacity 的 2 的幂，须能用 uint32_t 表示
+	static constexpr chrono::seconds ATTACH_TIMEOUT{5};	// 打开已存在的段时，等待创建者完成初始化的上限
+
+	struct ShmNode
+	{
+		int key;
+		int value;
+		uint32_t prev;			// LRU 双向链表
+		uint32_t next;
+		uint32_t hash_next;		// 哈希桶单链表；空闲节点也借用它串成空闲链表
+	};
+
+	struct ShmHeader
+	{
+		atomic<uint32_t> ready;		// 创建者初始化完成后置为 MAGIC
+		uint32_t capacity;
+		uint32_t bucket_count;
+		uint32_t size;
+		uint32_t head;
+		uint32_t tail;
+		uint32_t free_head;
+		uint64_t hits;
+		uint64_t misses;
+		uint64_t recoveries;		// 从 EOWNERDEAD 恢复的次数
+		pthread_mutex_t mtx;
+	};
+
+	string name_;
+	void* base_ = nullptr;
+	size_t mapped_size_ = 0;
+	ShmHeader* header_ = nullptr;
+	ShmNode* nodes_ = nullptr;
+	uint32_t* buckets_ = nullptr;
+
+	static size_t segment_size(uint32_t capacity, uint32_t bucket_count)
+	{
+		return sizeof(ShmHeader) + sizeof(ShmNode) * capacity + sizeof(uint32_t) * bucket_count;
+	}
+
+	void bind(void* base)
+	{
+		base_ = base;
+		header_ = static_cast<ShmHeader*>(base);
+		nodes_ = reinterpret_cast<ShmNode*>(header_ + 1);
+		buckets_ = reinterpret_cast<uint32_t*>(nodes_ + header_->capacity);
+	}
+
+	uint32_t bucket_of(int key) const noexcept
+	{
+		uint64_t h = static_cast<uint32_t>(key);
+		h ^= h >> 33;
+		h *= 0xff51afd7ed558ccdULL;
+		h ^= h >> 33;
+		return static_cast<uint32_t>(h) & (header_->bucket_count - 1);
+	}
+
+	// 清空：所有节点回到空闲链表。初始化与崩溃恢复共用
+	void reset() noexcept
+	{
+		for (uint32_t b = 0; b < header_->bucket_count; b++)
+		{
+			buckets_[b] = NIL;
+		}
+		for (uint32_t i = 0; i < header_->capacity; i++)
+		{
+			nodes_[i].hash_next = i + 1 < header_->capacity ? i + 1 : NIL;
+		}
+		header_->free_head = header_->capacity ? 0 : NIL;
+		header_->head = header_->tail = NIL;
+		header_->size = 0;
+	}
+
+	// 加锁；上一个持锁进程崩溃时清空缓存并恢复锁的一致性
+	void lock()
+	{
+		int rc = pthread_mutex_lock(&header_->mtx);
+		if (rc == EOWNERDEAD)
+		{
+			reset();
+			header_->recoveries++;
+			pthread_mutex_consistent(&header_->mtx);
+		}
+		else if (rc != 0)
+		{
+			throw runtime_error(string("pthread_mutex_lock: ") + strerror(rc));
+		}
+	}
+
+	void unlock() noexcept
+	{
+		pthread_mutex_unlock(&header_->mtx);
+	}
+
+	// 以下函数要求调用方已持锁
+	uint32_t find(int key) const noexcept
+	{
+		uint32_t i = buckets_[bucket_of(key)];
+		while (i != NIL && nodes_[i].key != key)
+		{
+			i = nodes_[i].hash_next;
+		}
+		return i;
+	}
+
+	void list_unlink(uint32_t i) noexcept
+	{
+		ShmNode& n = nodes_[i];
+		(n.prev != NIL ? nodes_[n.prev].next : header_->head) = n.next;
+		(n.next != NIL ? nodes_[n.next].prev : header_->tail) = n.prev;
+	}
+
+	void list_push_front(uint32_t i) noexcept
+	{
+		ShmNode& n = nodes_[i];
+		n.prev = NIL;
+		n.next = header_->head;
+		(header_->head != NIL ? nodes_[header_->head].prev : header_->tail) = i;
+		header_->head = i;
+	}
+
+	void hash_remove(uint32_t i) noexcept
+	{
+		uint32_t* link = &buckets_[bucket_of(nodes_[i].key)];
+		while (*link != i)
+		{
+			link = &nodes_[*link].hash_next;
+		}
+		*link = nodes_[i].hash_next;
+	}
+
+	// 持锁期间的作用域守卫
+	struct Guard
+	{
+		SharedLRUCache& cache;
+		explicit Guard(SharedLRUCache& c) : cache(c) { cache.lock(); }
+		~Guard() { cache.unlock(); }
+	};
+
+public:
+	// 打开名为 name 的共享段；不存在则以 capacity 创建并初始化，已存在则沿用段内的容量
+	SharedLRUCache(const string& name, uint32_t capacity) : name_(name)
+	{
+		if (capacity > MAX_CAPACITY)
+		{
+			throw invalid_argument("SharedLRUCache: capacity " + to_string(capacity) + " 超过上限 " + to_string(MAX_CAPACITY));
+		}
+
+		int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+		bool creator = fd >= 0;
+		if (!creator && errno == EEXIST)
+		{
+			fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+		}
+		if (fd < 0)
+		{
+			throw runtime_error("shm_open " + name + ": " + strerror(errno));
+		}
+
+		if (creator)
+		{
+			uint32_t bucket_count = 1;
+			while (bucket_count < capacity * 2)
+			{
+				bucket_count <<= 1;
+			}
+
+			mapped_size_ = segment_size(capacity, bucket_count);
+			if (::ftruncate(fd, static_cast<off_t>(mapped_size_)) != 0)
+			{
+				::close(fd);
+				::shm_unlink(name.c_str());
+				throw runtime_error("ftruncate " + name + ": " + strerror(errno));
+			}
+
+			void* base = ::mmap(nullptr, mapped_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+			::close(fd);
+			if (base == MAP_FAILED)
+			{
+				::shm_unlink(name.c_str());
+				throw runtime_error("mmap " + name + ": " + strerror(errno));
+			}
+
+			// ftruncate 得到的页全为 0，ready 初始即为 0；其余进程在 ready 置位前等待
+			ShmHeader* header = static_cast<ShmHeader*>(base);
+			header->capacity = capacity;
+			header->bucket_count = bucket_count;
+			header->hits = header->misses = header->recoveries = 0;
+
+			pthread_mutexattr_t attr;
+			pthread_mutexattr_init(&attr);
+			pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+			pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+			pthread_mutex_init(&header->mtx, &attr);
+			pthread_mutexattr_destroy(&attr);
+
+			bind(base);
+			reset();
+			header_->ready.store(MAGIC, memory_order_release);
+			return;
+		}
+
+		// 段已存在：等创建者把大小设好、初始化完成
+		// 创建者若在初始化途中崩溃，ready 永远不会置位：超过 ATTACH_TIMEOUT 就放弃，由调用方 unlink 后重建
+		auto deadline = chrono::steady_clock::now() + ATTACH_TIMEOUT;
+		struct stat st;
+		for (;;)
+		{
+			if (::fstat(fd, &st) != 0)
+			{
+				::close(fd);
+				throw runtime_error("fstat " + name + ": " + strerror(errno));
+			}
+			if (static_cast<size_t>(st.st_size) >= sizeof(ShmHeader))
+			{
+				break;
+			}
+			if (chrono::steady_clock::now() >= deadline)
+			{
+				::close(fd);
+				throw runtime_error("shm " + name + ": 等待创建者初始化超时（创建者可能已崩溃）");
+			}
+			this_thread::yield();
+		}
+
+		mapped_size_ = static_cast<size_t>(st.st_size);
+		void* base = ::mmap(nullptr, mapped_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		::close(fd);
+		if (base == MAP_FAILED)
+		{
+			throw runtime_error("mmap " + name + ": " + strerror(errno));
+		}
+
+		ShmHeader* header = static_cast<ShmHeader*>(base);
+		while (header->ready.load(memory_order_acquire) != MAGIC)
+		{
+			if (chrono::steady_clock::now() >= deadline)
+			{
+				::munmap(base, mapped_size_);
+				throw runtime_error("shm " + name + ": 等待创建者初始化超时（创建者可能已崩溃）");
+			}
+			this_thread::yield();
+		}
+
+		// 段内的容量和桶数决定了 bind 之后访问的范围：同名的旧段（布局不同）或损坏的段不能信任，先核对再使用
+		uint32_t seg_capacity = header->capacity;
+		uint32_t seg_buckets = header->bucket_count;
+		if (seg_capacity > MAX_CAPACITY || seg_buckets == 0 || (seg_buckets & (seg_buckets - 1)) != 0
+			|| mapped_size_ < segment_size(seg_capacity, seg_buckets))
+		{
+			::munmap(base, mapped_size_);
+			throw runtime_error("shm " + name + ": 段布局不符（capacity " + to_string(seg_capacity) + "，bucket_count "
+				+ to_string(seg_buckets) + "，大小 " + to_string(mapped_size_) + " 字节）");
+		}
+		bind(base);
+	}
+
+	~SharedLRUCache()
+	{
+		if (base_)
+		{
+			::munmap(base_, mapped_size_);
+		}
+	}
+
+	// 禁用拷贝构造和赋值运算符
+	SharedLRUCache(const SharedLRUCache& other) = delete;
+	SharedLRUCache& operator=(const SharedLRUCache& other) = delete;
+
+	// 删除共享段名字；已映射的进程不受影响，最后一个进程解除映射后内存才释放
+	static void unlink(const string& name)
+	{
+		::shm_unlink(name.c_str());
+	}
+
+	// 查询
+	int get(int key)
+	{
+		Guard guard(*this);
+		uint32_t i = find(key);
+		if (i == NIL)
+		{
+			header_->misses++;
+			return -1;
+		}
+
+		header_->hits++;
+		list_unlink(i);
+		list_push_front(i);
+		return nodes_[i].value;
+	}
+
+	// 存入
+	void put(int key, int value)
+	{
+		Guard guard(*this);
+		uint32_t i = find(key);
+		if (i != NIL)
+		{
+			nodes_[i].value = value;
+			list_unlink(i);
+			list_push_front(i);
+			return;
+		}
+
+		if (header_->capacity == 0)
+		{
+			return;
+		}
+
+		// 取空闲节点；没有则复用最旧的节点
+		if (header_->free_head != NIL)
+		{
+			i = header_->free_head;
+			header_->free_head = nodes_[i].hash_next;
+			header_->size++;
+		}
+		else
+		{
+			i = header_->tail;
+			list_unlink(i);
+			hash_remove(i);
+		}
+
+		ShmNode& n = nodes_[i];
+		n.key = key;
+		n.value = value;
+		uint32_t b = bucket_of(key);
+		n.hash_next = buckets_[b];
+		buckets_[b] = i;
+		list_push_front(i);
+	}
+
+	size_t size()
+	{
+		Guard guard(*this);
+		return header_->size;
+	}
+
+	size_t capacity() const noexcept
+	{
+		return header_->capacity;
+	}
+
+	uint64_t hits()
+	{
+		Guard guard(*this);
+		return header_->hits;
+	}
+
+	uint64_t misses()
+	{
+		Guard guard(*this);
+		return header_->misses;
+	}
+
+	uint64_t recoveries()
+	{
+		Guard guard(*this);
+		return header_->recoveries;
+	}
+
+	// 仅供演示：加锁后不解锁直接退出进程，模拟持锁时崩溃
+	[[noreturn]] void crash_while_locked()
+	{
+		lock();
+		_exit(0);
+	}
+};
+
+int main()
+{
+	const string name = "/lru_shm_demo";
+	const int workers = 4;
+	const int key_space = 20000;
+	SharedLRUCache::unlink(name);		// 清理上次异常退出残留的段
+
+	SharedLRUCache cache(name, 10000);
+
+	// 1. 多个 worker 进程读写同一个缓存：某个进程加载过的 key，其他进程直接命中
+	vector<pid_t> children;
+	for (int w = 0; w < workers; w++)
+	{
+		pid_t pid = fork();
+		if (pid == 0)
+		{
+			SharedLRUCache shared(name, 0);		// 段已存在，容量以段内为准
+			mt19937 gen(w);
+			uniform_int_distribution<int> dis(0, key_space - 1);
+			for (int i = 0; i < 100000; i++)
+			{
+				int key = dis(gen) % (dis(gen) + 1);		// 偏向小 key 的热点分布
+				if (shared.get(key) == -1)
+				{
+					shared.put(key, key * 2);
+				}
+			}
+			_exit(0);
+		}
+		children.push_back(pid);
+	}
+	for (pid_t pid : children)
+	{
+		waitpid(pid, nullptr, 0);
+	}
+
+	uint64_t hits = cache.hits(), misses = cache.misses();
+	cout << workers << " 个进程共享缓存：条目 " << cache.size() << " / " << cache.capacity()
+		 << "，命中率 " << 100.0 * hits / (hits + misses) << "%\n";
+
+	// 2. 持锁进程崩溃：下一个加锁者收到 EOWNERDEAD，清空缓存后继续工作，不会永久死锁
+	pid_t pid = fork();
+	if (pid == 0)
+	{
+		SharedLRUCache shared(name, 0);
+		shared.crash_while_locked();
+	}
+	waitpid(pid, nullptr, 0);
+
+	cache.put(1, 100);
+	cout << "崩溃恢复次数 " << cache.recoveries() << "，恢复后条目 " << cache.size() << "，key 1 -> " << cache.get(1) << "\n";
+
+	SharedLRUCache::unlink(name);
+	return 0;
+}
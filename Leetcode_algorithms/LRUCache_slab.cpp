@@ -0,0 +1,404 @@
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <random>
+#include <cstring>
+#include <cmath>
+#include <cstdint>
+
+using namespace std;
+
+/*
+ * LeetCode 146: LRU 缓存 —— memcached 风格的 slab 存储
+ * 原版把 value 存在 list<CacheNode> 节点中，每个 value 都是独立的堆对象，频繁换入换出后分配器碎片严重
+ * 做法：
+ * (1) 按大小分级 (size class)：chunk 大小从 64 字节起，每级乘以 1.25
+ * (2) 每级向总内存池申请 1 MB 的页，页被切成该级大小的 chunk；key、value 和条目头部放在同一个 chunk 中
+ * (3) 每级各自维护一条 LRU 链表：某级没有空闲 chunk 且内存池已用完时，只淘汰该级最旧的条目，
+ *     腾出的 chunk 大小恰好合适，不会出现“淘汰了一个大对象却仍放不下”的情况
+ * 内存以页为单位向系统申请，之后只在 chunk 粒度上复用，不再产生外部碎片
+ */
+
+class SlabAllocator
+{
+public:
+	static constexpr size_t PAGE_SIZE = 1 << 20;
+	static constexpr size_t MIN_CHUNK = 64;
+	static constexpr double GROWTH_FACTOR = 1.25;
+
+	struct ClassStats
+	{
+		size_t chunk_size;
+		size_t pages;
+		size_t used_chunks;
+		size_t free_chunks;
+	};
+
+private:
+	// 空闲 chunk 以单链表串起来，指针就存在 chunk 自身的前 8 个字节
+	struct FreeChunk
+	{
+		FreeChunk* next;
+	};
+
+	struct SlabClass
+	{
+		size_t chunk_size;
+		size_t pages = 0;
+		size_t used = 0;
+		size_t free_count = 0;
+		FreeChunk* free_list = nullptr;
+	};
+
+	size_t memory_limit_;
+	vector<unique_ptr<char[]>> pages_;
+	vector<SlabClass> classes_;
+
+	// 把一个新页切成 chunk，全部放进空闲链表
+	bool grow(SlabClass& cls)
+	{
+		if ((pages_.size() + 1) * PAGE_SIZE > memory_limit_)
+		{
+			return false;
+		}
+
+		pages_.push_back(make_unique<char[]>(PAGE_SIZE));
+		char* page = pages_.back().get();
+		size_t count = PAGE_SIZE / cls.chunk_size;
+		for (size_t i = 0; i < count; i++)
+		{
+			FreeChunk* chunk = reinterpret_cast<FreeChunk*>(page + i * cls.chunk_size);
+			chunk->next = cls.free_list;
+			cls.free_list = chunk;
+		}
+		cls.pages++;
+		cls.free_count += count;
+		return true;
+	}
+
+public:
+	explicit SlabAllocator(size_t memory_limit) : memory_limit_(memory_limit)
+	{
+		// 生成各级 chunk 大小（8 字节对齐），最后一级为整页
+		double size = MIN_CHUNK;
+		while (size < PAGE_SIZE / 2)
+		{
+			size_t aligned = (static_cast<size_t>(size) + 7) & ~size_t(7);
+			if (classes_.empty() || aligned > classes_.back().chunk_size)
+			{
+				classes_.push_back(SlabClass{aligned});
+			}
+			size *= GROWTH_FACTOR;
+		}
+		classes_.push_back(SlabClass{PAGE_SIZE});
+	}
+
+	// 禁用拷贝构造和赋值运算符
+	SlabAllocator(const SlabAllocator& other) = delete;
+	SlabAllocator& operator=(const SlabAllocator& other) = delete;
+
+	// 能容纳 size 字节的最小级别；超过最大 chunk 时返回 -1
+	int class_for(size_t size) const noexcept
+	{
+		size_t lo = 0, hi = classes_.size();
+		while (lo < hi)
+		{
+			size_t mid = (lo + hi) / 2;
+			if (classes_[mid].chunk_size < size)
+			{
+				lo = mid + 1;
+			}
+			else
+			{
+				hi = mid;
+			}
+		}
+		return lo < classes_.size() ? static_cast<int>(lo) : -1;
+	}
+
+	// 从指定级别取一个 chunk：先用空闲链表，再申请新页；内存池耗尽时返回 nullptr
+	void* allocate(int class_id)
+	{
+		SlabClass& cls = classes_[class_id];
+		if (!cls.free_list && !grow(cls))
+		{
+			return nullptr;
+		}
+
+		FreeChunk* chunk = cls.free_list;
+		cls.free_list = chunk->next;
+		cls.free_count--;
+		cls.used++;
+		return chunk;
+	}
+
+	void deallocate(int class_id, void* p) noexcept
+	{
+		SlabClass& cls = classes_[class_id];
+		FreeChunk* chunk = static_cast<FreeChunk*>(p);
+		chunk->next = cls.free_list;
+		cls.free_list = chunk;
+		cls.free_count++;
+		cls.used--;
+	}
+
+	size_t chunk_size(int class_id) const noexcept
+	{
+		return classes_[class_id].chunk_size;
+	}
+
+	size_t class_count() const noexcept
+	{
+		return classes_.size();
+	}
+
+	size_t allocated_bytes() const noexcept
+	{
+		return pages_.size() * PAGE_SIZE;
+	}
+
+	ClassStats stats(int class_id) const noexcept
+	{
+		const SlabClass& cls = classes_[class_id];
+		return ClassStats{cls.chunk_size, cls.pages, cls.used, cls.free_count};
+	}
+};
+
+class SlabLRUCache
+{
+	// 条目头部，紧跟着 key 和 value 的字节
+	struct Item
+	{
+		Item* prev;
+		Item* next;
+		uint32_t key_len;
+		uint32_t value_len;
+		int class_id;
+
+		char* key_data() noexcept
+		{
+			return reinterpret_cast<char*>(this + 1);
+		}
+
+		char* value_data() noexcept
+		{
+			return key_data() + key_len;
+		}
+
+		string_view key() noexcept
+		{
+			return string_view(key_data(), key_len);
+		}
+
+		string_view value() noexcept
+		{
+			return string_view(value_data(), value_len);
+		}
+	};
+
+	// 每级一条 LRU 双向链表
+	struct LRUList
+	{
+		Item* head = nullptr;
+		Item* tail = nullptr;
+	};
+
+	SlabAllocator slabs_;
+	vector<LRUList> lru_;
+
+	// 哈希表：key 的 string_view 直接指向 chunk 内的 key 字节，不额外存一份
+	unordered_map<string_view, Item*> index_;
+	size_t payload_bytes_ = 0;
+
+	void unlink(Item* item) noexcept
+	{
+		LRUList& l = lru_[item->class_id];
+		(item->prev ? item->prev->next : l.head) = item->next;
+		(item->next ? item->next->prev : l.tail) = item->prev;
+		item->prev = item->next = nullptr;
+	}
+
+	void push_front(Item* item) noexcept
+	{
+		LRUList& l = lru_[item->class_id];
+		item->prev = nullptr;
+		item->next = l.head;
+		(l.head ? l.head->prev : l.tail) = item;
+		l.head = item;
+	}
+
+	void remove(Item* item) noexcept
+	{
+		index_.erase(item->key());
+		unlink(item);
+		payload_bytes_ -= item->key_len + item->value_len;
+		slabs_.deallocate(item->class_id, item);
+	}
+
+	// 在指定级别取一个 chunk；内存池耗尽时淘汰同级最旧的条目
+	Item* allocate_item(int class_id)
+	{
+		void* p = slabs_.allocate(class_id);
+		if (!p && lru_[class_id].tail)
+		{
+			remove(lru_[class_id].tail);
+			p = slabs_.allocate(class_id);
+		}
+		return static_cast<Item*>(p);
+	}
+
+public:
+	explicit SlabLRUCache(size_t memory_limit) : slabs_(memory_limit)
+	{
+		lru_.resize(slabs_.class_count());
+	}
+
+	// 禁用拷贝构造和赋值运算符（哈希表的 key 指向 chunk 内部）
+	SlabLRUCache(const SlabLRUCache& other) = delete;
+	SlabLRUCache& operator=(const SlabLRUCache& other) = delete;
+
+	// 查询：返回指向 chunk 内 value 的视图，未命中返回默认构造的视图（data() 为 nullptr）
+	// 视图在下一次修改缓存之前有效
+	string_view get(string_view key)
+	{
+		auto it = index_.find(key);
+		if (it == index_.end())
+		{
+			return string_view();
+		}
+
+		Item* item = it->second;
+		unlink(item);
+		push_front(item);
+		return item->value();
+	}
+
+	// 存入：条目超过最大 chunk，或所属级别既无空闲也无可淘汰的条目时，返回 false
+	// （后一种情况是内存池已被其他级别占满；memcached 通过后台在级别间迁移页来缓解，这里不做）
+	bool put(string_view key, string_view value)
+	{
+		size_t total = sizeof(Item) + key.size() + value.size();
+		int class_id = slabs_.class_for(total);
+
+		auto it = index_.find(key);
+		if (it != index_.end())
+		{
+			// 仍属于同一级别，原地覆盖 value
+			Item* item = it->second;
+			if (item->class_id == class_id)
+			{
+				payload_bytes_ += value.size();
+				payload_bytes_ -= item->value_len;
+				item->value_len = static_cast<uint32_t>(value.size());
+				memmove(item->value_data(), value.data(), value.size());
+				unlink(item);
+				push_front(item);
+				return true;
+			}
+			remove(item);
+		}
+
+		if (class_id < 0)
+		{
+			return false;
+		}
+
+		Item* item = allocate_item(class_id);
+		if (!item)
+		{
+			return false;
+		}
+
+		item->key_len = static_cast<uint32_t>(key.size());
+		item->value_len = static_cast<uint32_t>(value.size());
+		item->class_id = class_id;
+		memcpy(item->key_data(), key.data(), key.size());
+		memcpy(item->value_data(), value.data(), value.size());
+
+		push_front(item);
+		index_.emplace(item->key(), item);
+		payload_bytes_ += key.size() + value.size();
+		return true;
+	}
+
+	bool erase(string_view key)
+	{
+		auto it = index_.find(key);
+		if (it == index_.end())
+		{
+			return false;
+		}
+		remove(it->second);
+		return true;
+	}
+
+	size_t size() const noexcept
+	{
+		return index_.size();
+	}
+
+	// key + value 的有效字节数
+	size_t payload_bytes() const noexcept
+	{
+		return payload_bytes_;
+	}
+
+	size_t allocated_bytes() const noexcept
+	{
+		return slabs_.allocated_bytes();
+	}
+
+	const SlabAllocator& slabs() const noexcept
+	{
+		return slabs_;
+	}
+};
+
+int main()
+{
+	// 1. 基本功能
+	SlabLRUCache cache(64 << 20);
+	cache.put("user:1", "alice");
+	cache.put("user:2", "bob");
+	cout << "user:1 -> " << cache.get("user:1") << "\n";
+	cache.put("user:1", string(1000, 'x'));		// 跨级别更新
+	cout << "user:1 长度 -> " << cache.get("user:1").size() << "\n";
+
+	// 2. 混合大小的 value 持续换入换出：16 字节到 16 KB，对数均匀分布
+	mt19937 gen(1);
+	uniform_real_distribution<double> log_size(4.0, 14.0);
+	uniform_int_distribution<int> key_dis(0, 200000);
+	string buffer(1 << 14, 'v');
+	size_t rejected = 0;
+
+	for (int i = 0; i < 1000000; i++)
+	{
+		string key = "k" + to_string(key_dis(gen));
+		size_t len = static_cast<size_t>(exp2(log_size(gen)));
+		if (cache.get(key).data() == nullptr && !cache.put(key, string_view(buffer.data(), len)))
+		{
+			rejected++;
+		}
+	}
+
+	cout << "条目数 " << cache.size() << "，有效数据 " << (cache.payload_bytes() >> 10) << " KB / 已申请 "
+		 << (cache.allocated_bytes() >> 10) << " KB，利用率 "
+		 << 100.0 * cache.payload_bytes() / cache.allocated_bytes() << "%，拒绝 " << rejected << " 次\n";
+
+	// 各级 chunk 的使用情况（只打印有页的级别）
+	const SlabAllocator& slabs = cache.slabs();
+	for (size_t c = 0; c < slabs.class_count(); c++)
+	{
+		SlabAllocator::ClassStats s = slabs.stats(static_cast<int>(c));
+		if (s.pages)
+		{
+			cout << "class " << c << ": chunk " << s.chunk_size << " B, 页 " << s.pages
+				 << ", 已用 " << s.used_chunks << ", 空闲 " << s.free_chunks << "\n";
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,266 @@
+#include <iostream>
+#include <list>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <chrono>
+
+#include <fcntl.h>		// open
+#include <sys/mman.h>	// mmap / munmap
+#include <sys/stat.h>	// fstat
+#include <unistd.h>		// write / close / fsync
+
+using namespace std;
+
+/*
+ * LeetCode 146: LRU 缓存 —— 快照与热重启 (POSIX)
+ * 每次发布后缓存都是冷的，后端要承受几分钟的流量冲击
+ * 做法：
+ * (1) save(): 按访问顺序（从新到旧）把全部条目写成紧凑的二进制文件
+ *     先写临时文件，fsync 后 rename 覆盖，进程中途崩溃也不会留下半个快照
+ * (2) load(): 用 mmap 映射文件，条目是定长的 {key, value} 数组，直接按下标读取，不需要逐条解析
+ *
+ * 文件格式（本机字节序，快照只在同一类机器间使用）：
+ *   SnapshotHeader { magic, version, count, capacity }
+ *   SnapshotRecord[count] { key, value }    —— 第 0 条最新
+ */
+
+struct SnapshotHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t count;
+	uint64_t capacity;
+};
+
+struct SnapshotRecord
+{
+	int32_t key;
+	int32_t value;
+};
+
+class SnapshotLRUCache
+{
+	static constexpr uint32_t MAGIC = 0x4C525553;		// "SURL"
+	static constexpr uint32_t VERSION = 1;
+
+	using CacheNode = pair<int, int>;
+
+	size_t capacity_;
+
+	// 双向链表
+	list<CacheNode> cache_list_;
+
+	// 哈希表
+	unordered_map<int, list<CacheNode>::iterator> key_to_iter_;
+
+	// 一次写完整块缓冲区，处理 write 部分写入以及被信号打断 (EINTR) 的情况
+	static bool write_all(int fd, const void* data, size_t len)
+	{
+		const char* p = static_cast<const char*>(data);
+		while (len > 0)
+		{
+			ssize_t n = ::write(fd, p, len);
+			if (n < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+				return false;
+			}
+			p += n;
+			len -= static_cast<size_t>(n);
+		}
+		return true;
+	}
+
+public:
+	explicit SnapshotLRUCache(size_t capacity) : capacity_(capacity)
+	{
+
+	}
+
+	// 禁用拷贝构造和赋值运算符
+	SnapshotLRUCache(const SnapshotLRUCache& other) = delete;
+	SnapshotLRUCache& operator=(const SnapshotLRUCache& other) = delete;
+
+	// 查询
+	int get(int key)
+	{
+		auto it = key_to_iter_.find(key);
+		if (it == key_to_iter_.end())
+		{
+			return -1;
+		}
+
+		cache_list_.splice(cache_list_.begin(), cache_list_, it->second);
+		return it->second->second;
+	}
+
+	// 存入
+	void put(int key, int value)
+	{
+		auto it = key_to_iter_.find(key);
+		if (it != key_to_iter_.end())
+		{
+			it->second->second = value;
+			cache_list_.splice(cache_list_.begin(), cache_list_, it->second);
+			return;
+		}
+
+		if (capacity_ == 0)
+		{
+			return;
+		}
+
+		if (cache_list_.size() >= capacity_)
+		{
+			key_to_iter_.erase(cache_list_.back().first);
+			cache_list_.pop_back();
+		}
+
+		cache_list_.emplace_front(key, value);
+		key_to_iter_[key] = cache_list_.begin();
+	}
+
+	// 保存快照：成功返回 true
+	bool save(const string& path) const
+	{
+		string tmp_path = path + ".tmp";
+		int fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		if (fd < 0)
+		{
+			return false;
+		}
+
+		// 整个快照先在内存中拼好，再一次性写出
+		vector<char> buffer(sizeof(SnapshotHeader) + cache_list_.size() * sizeof(SnapshotRecord));
+		SnapshotHeader header{MAGIC, VERSION, cache_list_.size(), capacity_};
+		memcpy(buffer.data(), &header, sizeof(header));
+
+		SnapshotRecord* records = reinterpret_cast<SnapshotRecord*>(buffer.data() + sizeof(header));
+		size_t i = 0;
+		for (const auto& node : cache_list_)
+		{
+			records[i++] = SnapshotRecord{node.first, node.second};
+		}
+
+		bool ok = write_all(fd, buffer.data(), buffer.size()) && ::fsync(fd) == 0;
+		ok = (::close(fd) == 0) && ok;
+		if (!ok || std::rename(tmp_path.c_str(), path.c_str()) != 0)
+		{
+			::unlink(tmp_path.c_str());
+			return false;
+		}
+		return true;
+	}
+
+	// 加载快照：清空当前内容后按原访问顺序恢复
+	// 快照条目多于容量时只保留最新的 capacity_ 条；文件不存在或格式不符时返回 false，缓存保持为空
+	bool load(const string& path)
+	{
+		cache_list_.clear();
+		key_to_iter_.clear();
+
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+		{
+			return false;
+		}
+
+		struct stat st;
+		if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(SnapshotHeader))
+		{
+			::close(fd);
+			return false;
+		}
+
+		size_t file_size = static_cast<size_t>(st.st_size);
+		void* addr = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd);		// 映射建立后即可关闭文件描述符
+		if (addr == MAP_FAILED)
+		{
+			return false;
+		}
+
+		// 顺序读取整个文件，提示内核提前预读
+		::madvise(addr, file_size, MADV_SEQUENTIAL);
+
+		const SnapshotHeader* header = static_cast<const SnapshotHeader*>(addr);
+		bool ok = header->magic == MAGIC && header->version == VERSION
+			&& header->count <= (file_size - sizeof(SnapshotHeader)) / sizeof(SnapshotRecord);
+
+		if (ok)
+		{
+			const SnapshotRecord* records = reinterpret_cast<const SnapshotRecord*>(static_cast<const char*>(addr) + sizeof(SnapshotHeader));
+			key_to_iter_.reserve(min<size_t>(header->count, capacity_));
+
+			// 记录按从新到旧排列，依次追加到表尾即可还原访问顺序
+			// 重复的 key 只保留最新的一条且不占名额：遍历全部记录，凑满 capacity_ 条为止
+			for (size_t i = 0; i < header->count && cache_list_.size() < capacity_; i++)
+			{
+				if (key_to_iter_.count(records[i].key))
+				{
+					continue;
+				}
+				cache_list_.emplace_back(records[i].key, records[i].value);
+				key_to_iter_[records[i].key] = prev(cache_list_.end());
+			}
+		}
+
+		::munmap(addr, file_size);
+		return ok;
+	}
+
+	size_t size() const noexcept
+	{
+		return cache_list_.size();
+	}
+};
+
+int main()
+{
+	const string path = "lru_snapshot.bin";
+	const size_t capacity = 1000000;
+
+	// 1. 填满缓存并保存快照
+	SnapshotLRUCache before(capacity);
+	for (int i = 0; i < static_cast<int>(capacity); i++)
+	{
+		before.put(i, i * 2);
+	}
+	before.get(0);		// key 0 成为最新
+
+	auto start = chrono::steady_clock::now();
+	if (!before.save(path))
+	{
+		cerr << "保存快照失败\n";
+		return 1;
+	}
+	chrono::duration<double, milli> save_ms = chrono::steady_clock::now() - start;
+
+	// 2. “重启”：新实例从快照恢复
+	SnapshotLRUCache after(capacity);
+	start = chrono::steady_clock::now();
+	if (!after.load(path))
+	{
+		cerr << "加载快照失败\n";
+		return 1;
+	}
+	chrono::duration<double, milli> load_ms = chrono::steady_clock::now() - start;
+
+	cout << "条目数 " << after.size() << "，保存 " << save_ms.count() << " ms，恢复 " << load_ms.count() << " ms\n";
+
+	// 访问顺序被保留：再插入一个新 key，被淘汰的应是最旧的 key 1，而不是刚访问过的 key 0
+	after.put(-1, -1);
+	cout << "key 0: " << after.get(0) << ", key 1: " << after.get(1) << "\n";		// 0, -1
+
+	std::remove(path.c_str());
+	return 0;
+}
@@ -0,0 +1,607 @@
+#include <iostream>
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <string>
+#include <sstream>
+#include <memory>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+
+/*
+ * LeetCode 146: LRU 缓存 —— 统计与热度观测
+ * 原版 LRUCache 对外完全不透明：命中多少、淘汰多快、数据被多久复用一次，都无从得知
+ * 提供三类观测，最终输出为一个 JSON 快照：
+ * (1) 计数器：hits / misses / inserts / updates / evictions
+ *     按线程分条 (striped) 存放，每个线程写自己的缓存行，读取时再汇总 —— 热路径上没有共享写
+ * (2) 复用距离直方图（可选）：按 key 哈希抽样 1/rate，记录每个抽样 key 最近一次访问的时间戳，
+ *     复用距离 = 两次访问之间访问过的不同 key 数（树状数组计数，O(log n)），按 2 的幂分桶，乘以 rate 还原到全量
+ *     —— 直方图直接回答“容量为 C 时命中率大约是多少”
+ * (3) 热点 key Top-N（可选）：Space-Saving 算法，固定数量的计数器（小顶堆）近似统计最频繁的 key
+ */
+
+static uint64_t stats_mix(uint64_t h) noexcept
+{
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+	return h;
+}
+
+// 分条计数器：每个线程第一次使用时分配一个条带下标
+class StripedCounters
+{
+public:
+	enum Counter { Hits, Misses, Inserts, Updates, Evictions, COUNT };
+
+private:
+	static constexpr size_t STRIPES = 64;
+
+	struct alignas(64) Stripe
+	{
+		atomic<uint64_t> values[COUNT];
+	};
+
+	Stripe stripes_[STRIPES];
+
+	static size_t stripe_index()
+	{
+		static atomic<size_t> next{0};
+		thread_local size_t index = next.fetch_add(1, memory_order_relaxed) % STRIPES;
+		return index;
+	}
+
+public:
+	StripedCounters()
+	{
+		for (auto& s : stripes_)
+		{
+			for (auto& v : s.values)
+			{
+				v.store(0, memory_order_relaxed);
+			}
+		}
+	}
+
+	void add(Counter c, uint64_t n = 1) noexcept
+	{
+		stripes_[stripe_index()].values[c].fetch_add(n, memory_order_relaxed);
+	}
+
+	// 汇总所有条带：读取期间仍有写入时，结果是近似值
+	uint64_t read(Counter c) const noexcept
+	{
+		uint64_t total = 0;
+		for (const auto& s : stripes_)
+		{
+			total += s.values[c].load(memory_order_relaxed);
+		}
+		return total;
+	}
+};
+
+// 抽样复用距离直方图
+// Olken 算法：每次抽样访问分配一个递增的时间戳，树状数组 (Fenwick) 中只有每个 key 最近一次访问的时间戳位置为 1
+// 复用距离 = 上次访问与本次之间为 1 的位置个数，一次前缀和查询 O(log n)，不再逐个遍历 LRU 栈
+class ReuseDistanceSampler
+{
+	static constexpr size_t BUCKETS = 40;
+
+	uint32_t rate_mask_;
+	size_t max_tracked_;
+
+	mutex mtx_;
+	// 时间戳空间为 2 * max_tracked；用完时把仍然有效的时间戳按顺序重新编号（压缩），均摊 O(1)
+	vector<uint32_t> tree_;		// 树状数组，下标从 1 开始
+	vector<int> key_at_;		// 时间戳 -> key
+	vector<uint8_t> live_;		// 时间戳是否为该 key 最近一次访问
+	unordered_map<int, uint32_t> last_access_;
+	uint32_t now_ = 0;			// 下一个时间戳
+	uint32_t oldest_ = 0;		// 最早的有效时间戳不早于此
+	uint64_t histogram_[BUCKETS] = {};
+	uint64_t cold_ = 0;		// 首次访问（或已超出跟踪范围）
+
+	void tree_add(uint32_t ts, int delta) noexcept
+	{
+		for (size_t i = ts + 1; i < tree_.size(); i += i & (~i + 1))
+		{
+			tree_[i] += delta;
+		}
+	}
+
+	// 时间戳 [0, ts) 中有效位置的个数
+	uint32_t tree_prefix(uint32_t ts) const noexcept
+	{
+		uint32_t sum = 0;
+		for (size_t i = ts; i > 0; i -= i & (~i + 1))
+		{
+			sum += tree_[i];
+		}
+		return sum;
+	}
+
+	void set_live(uint32_t ts, int key)
+	{
+		key_at_[ts] = key;
+		live_[ts] = 1;
+		tree_add(ts, 1);
+	}
+
+	void clear_live(uint32_t ts) noexcept
+	{
+		live_[ts] = 0;
+		tree_add(ts, -1);
+	}
+
+	// 有效时间戳按原顺序重新编号为 0..n-1，重建树状数组
+	void compact()
+	{
+		uint32_t next = 0;
+		for (uint32_t ts = 0; ts < now_; ts++)
+		{
+			if (live_[ts])
+			{
+				key_at_[next] = key_at_[ts];
+				last_access_[key_at_[next]] = next;
+				next++;
+			}
+		}
+		fill(live_.begin(), live_.end(), 0);
+		fill(live_.begin(), live_.begin() + next, 1);
+
+		// 线性时间建树：每个节点把自己的值加到父节点
+		fill(tree_.begin(), tree_.end(), 0);
+		for (size_t i = 1; i < tree_.size(); i++)
+		{
+			tree_[i] += live_[i - 1];
+			size_t parent = i + (i & (~i + 1));
+			if (parent < tree_.size())
+			{
+				tree_[parent] += tree_[i];
+			}
+		}
+
+		now_ = next;
+		oldest_ = 0;
+	}
+
+public:
+	// rate 取 2 的幂；max_tracked 限制跟踪的 key 数，超过部分的距离视为无穷大
+	explicit ReuseDistanceSampler(uint32_t rate = 64, size_t max_tracked = 1 << 16)
+		: max_tracked_(max(max_tracked, size_t(1)))
+	{
+		uint32_t r = 1;
+		while (r < rate)
+		{
+			r <<= 1;
+		}
+		rate_mask_ = r - 1;
+
+		size_t span = 2 * max_tracked_;
+		tree_.assign(span + 1, 0);
+		key_at_.assign(span, 0);
+		live_.assign(span, 0);
+	}
+
+	uint32_t rate() const noexcept
+	{
+		return rate_mask_ + 1;
+	}
+
+	// 未被抽中的 key 只做一次哈希判断，不加锁
+	void record(int key)
+	{
+		if ((stats_mix(static_cast<uint32_t>(key)) & rate_mask_) != 0)
+		{
+			return;
+		}
+
+		lock_guard<mutex> lock(mtx_);
+		if (now_ == live_.size())
+		{
+			compact();
+		}
+
+		auto it = last_access_.find(key);
+		if (it == last_access_.end())
+		{
+			cold_++;
+
+			// 跟踪的 key 数已满：丢弃最久未访问的 key（时间戳最小的有效位置）
+			if (last_access_.size() >= max_tracked_)
+			{
+				while (!live_[oldest_])
+				{
+					oldest_++;
+				}
+				clear_live(oldest_);
+				last_access_.erase(key_at_[oldest_]);
+			}
+			last_access_.emplace(key, now_);
+		}
+		else
+		{
+			// 两次访问之间访问过的不同 key 数，即抽样空间中的复用距离
+			uint32_t last = it->second;
+			size_t distance = tree_prefix(now_) - tree_prefix(last + 1);
+
+			size_t bucket = 0;
+			while ((size_t(1) << bucket) <= distance && bucket + 1 < BUCKETS)
+			{
+				bucket++;
+			}
+			histogram_[bucket]++;
+
+			clear_live(last);
+			it->second = now_;
+		}
+
+		set_live(now_, key);
+		now_++;
+	}
+
+	// JSON 片段：lt 为还原到全量后的距离上界（不含），即该桶统计距离 < lt 且不小于上一个桶的 lt
+	string to_json()
+	{
+		lock_guard<mutex> lock(mtx_);
+		ostringstream oss;
+		oss << "{\"sample_rate\":" << rate() << ",\"cold\":" << cold_ << ",\"buckets\":[";
+		bool first = true;
+		for (size_t b = 0; b < BUCKETS; b++)
+		{
+			if (histogram_[b] == 0)
+			{
+				continue;
+			}
+			oss << (first ? "" : ",") << "{\"lt\":" << (uint64_t(1) << b) * rate() << ",\"count\":" << histogram_[b] << "}";
+			first = false;
+		}
+		oss << "]}";
+		return oss.str();
+	}
+};
+
+// Space-Saving Top-N：维护 capacity 个计数器；新 key 替换最小计数器，并继承其计数（误差上界）
+// 计数器组织成按 count 排序的小顶堆，加上 key -> 堆下标的索引：计数加一和替换最小值都是 O(log capacity)
+class HotKeyTracker
+{
+	struct Counter
+	{
+		int key;
+		uint64_t count;
+		uint64_t error;
+	};
+
+	size_t top_n_;
+	size_t capacity_;
+	uint32_t rate_mask_;
+
+	mutex mtx_;
+	vector<Counter> heap_;
+	unordered_map<int, size_t> index_;		// key -> heap_ 下标
+	uint64_t total_ = 0;					// 抽中的访问总数
+
+	void swap_nodes(size_t a, size_t b)
+	{
+		swap(heap_[a], heap_[b]);
+		index_[heap_[a].key] = a;
+		index_[heap_[b].key] = b;
+	}
+
+	// 计数只增不减，只需要向下调整
+	void sift_down(size_t i)
+	{
+		for (;;)
+		{
+			size_t smallest = i;
+			size_t left = 2 * i + 1;
+			size_t right = left + 1;
+			if (left < heap_.size() && heap_[left].count < heap_[smallest].count)
+			{
+				smallest = left;
+			}
+			if (right < heap_.size() && heap_[right].count < heap_[smallest].count)
+			{
+				smallest = right;
+			}
+			if (smallest == i)
+			{
+				return;
+			}
+			swap_nodes(i, smallest);
+			i = smallest;
+		}
+	}
+
+	void sift_up(size_t i)
+	{
+		while (i > 0 && heap_[(i - 1) / 2].count > heap_[i].count)
+		{
+			swap_nodes(i, (i - 1) / 2);
+			i = (i - 1) / 2;
+		}
+	}
+
+public:
+	// 只统计 1/rate 的访问，计数器数量取 top_n 的 4 倍以降低误差
+	explicit HotKeyTracker(size_t top_n, uint32_t rate = 16)
+		: top_n_(top_n), capacity_(top_n * 4)
+	{
+		uint32_t r = 1;
+		while (r < rate)
+		{
+			r <<= 1;
+		}
+		rate_mask_ = r - 1;
+		heap_.reserve(capacity_);
+		index_.reserve(capacity_);
+	}
+
+	void record(int key)
+	{
+		// 按访问抽样（与 key 无关），热点 key 被抽中的概率与其频率成正比
+		thread_local uint64_t state = stats_mix(reinterpret_cast<uintptr_t>(&state));
+		state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+		if (((state >> 33) & rate_mask_) != 0)
+		{
+			return;
+		}
+
+		lock_guard<mutex> lock(mtx_);
+		total_++;
+		auto it = index_.find(key);
+		if (it != index_.end())
+		{
+			heap_[it->second].count++;
+			sift_down(it->second);
+			return;
+		}
+
+		if (heap_.size() < capacity_)
+		{
+			heap_.push_back(Counter{key, 1, 0});
+			index_[key] = heap_.size() - 1;
+			sift_up(heap_.size() - 1);
+			return;
+		}
+
+		// 替换堆顶（最小计数器）
+		Counter& victim = heap_[0];
+		index_.erase(victim.key);
+		victim = Counter{key, victim.count + 1, victim.count};
+		index_[key] = 0;
+		sift_down(0);
+	}
+
+	// 计数已按抽样率还原
+	// 只输出确定的热点：count - error 是真实计数的下界，要求它超过 total / capacity
+	// （Space-Saving 保证频率高于此值的 key 一定在计数器中），被替换进来的噪声 key 下界接近 0，不会输出
+	string to_json()
+	{
+		lock_guard<mutex> lock(mtx_);
+		uint64_t threshold = capacity_ ? total_ / capacity_ : 0;
+		vector<Counter> items;
+		for (const Counter& c : heap_)
+		{
+			if (c.count - c.error > threshold)
+			{
+				items.push_back(c);
+			}
+		}
+		sort(items.begin(), items.end(), [](const Counter& a, const Counter& b) { return a.count > b.count; });
+		if (items.size() > top_n_)
+		{
+			items.resize(top_n_);
+		}
+
+		ostringstream oss;
+		oss << "[";
+		for (size_t i = 0; i < items.size(); i++)
+		{
+			oss << (i ? "," : "") << "{\"key\":" << items[i].key
+				<< ",\"count\":" << items[i].count * (rate_mask_ + 1)
+				<< ",\"error\":" << items[i].error * (rate_mask_ + 1) << "}";
+		}
+		oss << "]";
+		return oss.str();
+	}
+};
+
+// 统计选项：复用距离和热点 key 默认关闭
+struct StatsOptions
+{
+	bool reuse_distance = false;
+	uint32_t reuse_sample_rate = 64;
+	size_t top_n = 0;
+};
+
+// 带统计的 LRU 缓存：结构与原版一致，外加一把锁；计数器在锁外更新，不拉长临界区
+class StatsLRUCache
+{
+	using CacheNode = pair<int, int>;
+
+	size_t capacity_;
+	mutex mtx_;
+
+	// 双向链表
+	list<CacheNode> cache_list_;
+
+	// 哈希表
+	unordered_map<int, list<CacheNode>::iterator> key_to_iter_;
+
+	StripedCounters counters_;
+	unique_ptr<ReuseDistanceSampler> reuse_;
+	unique_ptr<HotKeyTracker> hot_keys_;
+
+	void observe(int key)
+	{
+		if (reuse_)
+		{
+			reuse_->record(key);
+		}
+		if (hot_keys_)
+		{
+			hot_keys_->record(key);
+		}
+	}
+
+public:
+	explicit StatsLRUCache(size_t capacity, const StatsOptions& options = StatsOptions()) : capacity_(capacity)
+	{
+		if (options.reuse_distance)
+		{
+			reuse_ = make_unique<ReuseDistanceSampler>(options.reuse_sample_rate);
+		}
+		if (options.top_n > 0)
+		{
+			hot_keys_ = make_unique<HotKeyTracker>(options.top_n);
+		}
+	}
+
+	// 禁用拷贝构造和赋值运算符
+	StatsLRUCache(const StatsLRUCache& other) = delete;
+	StatsLRUCache& operator=(const StatsLRUCache& other) = delete;
+
+	// 查询
+	int get(int key)
+	{
+		int result = -1;
+		{
+			lock_guard<mutex> lock(mtx_);
+			auto it = key_to_iter_.find(key);
+			if (it != key_to_iter_.end())
+			{
+				cache_list_.splice(cache_list_.begin(), cache_list_, it->second);
+				result = it->second->second;
+			}
+		}
+
+		counters_.add(result == -1 ? StripedCounters::Misses : StripedCounters::Hits);
+		observe(key);
+		return result;
+	}
+
+	// 存入
+	void put(int key, int value)
+	{
+		bool updated = false;
+		bool inserted = false;
+		bool evicted = false;
+		{
+			lock_guard<mutex> lock(mtx_);
+			auto it = key_to_iter_.find(key);
+			if (it != key_to_iter_.end())
+			{
+				it->second->second = value;
+				cache_list_.splice(cache_list_.begin(), cache_list_, it->second);
+				updated = true;
+			}
+			else if (capacity_ > 0)
+			{
+				if (cache_list_.size() >= capacity_)
+				{
+					key_to_iter_.erase(cache_list_.back().first);
+					cache_list_.pop_back();
+					evicted = true;
+				}
+				cache_list_.emplace_front(key, value);
+				key_to_iter_[key] = cache_list_.begin();
+				inserted = true;
+			}
+		}
+
+		// 容量为 0 时什么都没存，不计入插入次数
+		if (updated)
+		{
+			counters_.add(StripedCounters::Updates);
+		}
+		else if (inserted)
+		{
+			counters_.add(StripedCounters::Inserts);
+		}
+		if (evicted)
+		{
+			counters_.add(StripedCounters::Evictions);
+		}
+	}
+
+	size_t size()
+	{
+		lock_guard<mutex> lock(mtx_);
+		return cache_list_.size();
+	}
+
+	// 当前统计的 JSON 快照
+	string stats_json()
+	{
+		uint64_t hits = counters_.read(StripedCounters::Hits);
+		uint64_t misses = counters_.read(StripedCounters::Misses);
+		double hit_ratio = hits + misses ? static_cast<double>(hits) / (hits + misses) : 0.0;
+
+		ostringstream oss;
+		oss << "{\"capacity\":" << capacity_
+			<< ",\"size\":" << size()
+			<< ",\"hits\":" << hits
+			<< ",\"misses\":" << misses
+			<< ",\"hit_ratio\":" << hit_ratio
+			<< ",\"inserts\":" << counters_.read(StripedCounters::Inserts)
+			<< ",\"updates\":" << counters_.read(StripedCounters::Updates)
+			<< ",\"evictions\":" << counters_.read(StripedCounters::Evictions);
+		if (reuse_)
+		{
+			oss << ",\"reuse_distance\":" << reuse_->to_json();
+		}
+		if (hot_keys_)
+		{
+			oss << ",\"hot_keys\":" << hot_keys_->to_json();
+		}
+		oss << "}";
+		return oss.str();
+	}
+};
+
+int main()
+{
+	StatsOptions options;
+	options.reuse_distance = true;
+	options.reuse_sample_rate = 16;
+	options.top_n = 5;
+	StatsLRUCache cache(2000, options);
+
+	// 4 个线程：80% 的访问落在 1000 个热 key 上，其余分散在 10 万个 key 上
+	vector<thread> threads;
+	for (int t = 0; t < 4; t++)
+	{
+		threads.emplace_back([&cache, t]
+		{
+			mt19937 gen(t);
+			uniform_int_distribution<int> pick(0, 99);
+			uniform_int_distribution<int> hot(0, 999);
+			uniform_int_distribution<int> cold(1000, 100999);
+			for (int i = 0; i < 200000; i++)
+			{
+				// key 0 被额外频繁访问，应出现在热点 Top-N 之首
+				int key = (i % 10 == 0) ? 0 : (pick(gen) < 80 ? hot(gen) : cold(gen));
+				if (cache.get(key) == -1)
+				{
+					cache.put(key, key);
+				}
+			}
+		});
+	}
+	for (auto& th : threads)
+	{
+		th.join();
+	}
+
+	cout << cache.stats_json() << "\n";
+	return 0;
+}
@@ -0,0 +1,384 @@
+#include <iostream>
+#include <list>
+#include <unordered_map>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <optional>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+#include <random>
+
+#include <fcntl.h>		// open
+#include <unistd.h>		// pread / pwrite / close / unlink
+
+using namespace std;
+
+/*
+ * LeetCode 146: LRU 缓存 —— 内存 + 本地磁盘两级缓存 (POSIX)
+ * 工作集约为内存的 10 倍，内存层淘汰一个条目就意味着下次要回源后端
+ * 做法：
+ * (1) 第一级：原版的 list + unordered_map 内存 LRU
+ * (2) 第二级：内存层淘汰的条目追加写入一个日志结构的段文件 (append-only)，内存中只保留 key -> {偏移, 长度} 索引
+ * (3) 内存未命中时先查磁盘索引，命中则 pread 读回并提升到内存层（磁盘上的旧记录变为垃圾）
+ * (4) 段文件超过磁盘预算时做一次压缩：把仍然有效的记录顺序重写到新文件，再替换旧文件
+ *     有效数据超过低水位时丢弃最早写入的记录，保证两次压缩之间有足够的追加空间
+ *
+ * 磁盘记录格式：RecordHeader { key_len, value_len } + key 字节 + value 字节
+ */
+
+class TieredLRUCache
+{
+	using CacheNode = pair<string, string>;
+
+	struct RecordHeader
+	{
+		uint32_t key_len;
+		uint32_t value_len;
+	};
+
+	// 磁盘索引：记录在段文件中的位置
+	struct DiskLocation
+	{
+		uint64_t offset;
+		uint32_t value_len;
+	};
+
+	size_t capacity_;
+
+	// 双向链表
+	list<CacheNode> cache_list_;
+
+	// 哈希表
+	unordered_map<string, list<CacheNode>::iterator> key_to_iter_;
+
+	// 第二级：段文件与索引
+	string segment_path_;
+	int fd_ = -1;
+	uint64_t write_offset_ = 0;
+	uint64_t live_bytes_ = 0;
+	uint64_t disk_budget_;
+	unordered_map<string, DiskLocation> disk_index_;
+
+	size_t disk_hits_ = 0;
+
+	static uint64_t record_size(size_t key_len, size_t value_len)
+	{
+		return sizeof(RecordHeader) + key_len + value_len;
+	}
+
+	// 以下两个函数处理部分读写以及被信号打断 (EINTR) 的情况
+	static bool pwrite_all(int fd, const char* data, size_t len, uint64_t offset)
+	{
+		while (len > 0)
+		{
+			ssize_t n = ::pwrite(fd, data, len, static_cast<off_t>(offset));
+			if (n < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+				return false;
+			}
+			data += n;
+			len -= static_cast<size_t>(n);
+			offset += static_cast<uint64_t>(n);
+		}
+		return true;
+	}
+
+	static bool pread_all(int fd, char* data, size_t len, uint64_t offset)
+	{
+		while (len > 0)
+		{
+			ssize_t n = ::pread(fd, data, len, static_cast<off_t>(offset));
+			if (n < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			if (n <= 0)
+			{
+				return false;
+			}
+			data += n;
+			len -= static_cast<size_t>(n);
+			offset += static_cast<uint64_t>(n);
+		}
+		return true;
+	}
+
+	// 从磁盘索引中删除（记录本身留在文件中，成为垃圾，等待压缩）
+	void drop_from_disk(const string& key)
+	{
+		auto it = disk_index_.find(key);
+		if (it != disk_index_.end())
+		{
+			live_bytes_ -= record_size(key.size(), it->second.value_len);
+			disk_index_.erase(it);
+		}
+	}
+
+	// 追加一条记录到段文件末尾
+	void spill(const string& key, const string& value)
+	{
+		if (fd_ < 0)
+		{
+			return;
+		}
+
+		uint64_t size = record_size(key.size(), value.size());
+		if (size > disk_budget_)
+		{
+			return;
+		}
+		if (write_offset_ + size > disk_budget_)
+		{
+			compact(size);
+		}
+
+		// 压缩后仍放不下：有效数据已占满预算，放弃这条记录
+		if (write_offset_ + size > disk_budget_)
+		{
+			return;
+		}
+
+		vector<char> buffer(size);
+		RecordHeader header{static_cast<uint32_t>(key.size()), static_cast<uint32_t>(value.size())};
+		memcpy(buffer.data(), &header, sizeof(header));
+		memcpy(buffer.data() + sizeof(header), key.data(), key.size());
+		memcpy(buffer.data() + sizeof(header) + key.size(), value.data(), value.size());
+
+		if (!pwrite_all(fd_, buffer.data(), buffer.size(), write_offset_))
+		{
+			return;
+		}
+
+		drop_from_disk(key);
+		disk_index_[key] = DiskLocation{write_offset_ + sizeof(RecordHeader) + key.size(), static_cast<uint32_t>(value.size())};
+		write_offset_ += size;
+		live_bytes_ += size;
+	}
+
+	// 压缩：有效记录顺序写入新文件后原子替换；有效数据仍然超预算时，按写入顺序丢弃最早的记录
+	void compact(uint64_t incoming)
+	{
+		string tmp_path = segment_path_ + ".compact";
+		int new_fd = ::open(tmp_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+		if (new_fd < 0)
+		{
+			return;
+		}
+
+		// 按旧偏移排序，顺序读旧文件
+		vector<pair<uint64_t, string>> order;
+		order.reserve(disk_index_.size());
+		for (const auto& [key, loc] : disk_index_)
+		{
+			order.emplace_back(loc.offset, key);
+		}
+		sort(order.begin(), order.end());
+
+		// 有效数据降到低水位（预算的 3/4）以下：从最早写入的记录开始丢弃
+		// 只腾出刚好放下新记录的空间时，之后每次溢出都会再压缩一次、重写整个文件；
+		// 留出 1/4 预算的余量后，两次压缩之间至少能追加 budget/4 字节，重写的开销被均摊
+		uint64_t low_water = disk_budget_ / 4 * 3;
+		size_t first_kept = 0;
+		uint64_t kept_bytes = live_bytes_;
+		while (first_kept < order.size() && kept_bytes + incoming > low_water)
+		{
+			const string& key = order[first_kept].second;
+			kept_bytes -= record_size(key.size(), disk_index_[key].value_len);
+			first_kept++;
+		}
+
+		unordered_map<string, DiskLocation> new_index;
+		uint64_t new_offset = 0;
+		vector<char> buffer;
+		for (size_t i = first_kept; i < order.size(); i++)
+		{
+			const string& key = order[i].second;
+			DiskLocation loc = disk_index_[key];
+			uint64_t record_start = loc.offset - key.size() - sizeof(RecordHeader);
+			uint64_t size = record_size(key.size(), loc.value_len);
+
+			buffer.resize(size);
+			if (!pread_all(fd_, buffer.data(), size, record_start) || !pwrite_all(new_fd, buffer.data(), size, new_offset))
+			{
+				::close(new_fd);
+				::unlink(tmp_path.c_str());
+				return;
+			}
+
+			new_index[key] = DiskLocation{new_offset + sizeof(RecordHeader) + key.size(), loc.value_len};
+			new_offset += size;
+		}
+
+		if (std::rename(tmp_path.c_str(), segment_path_.c_str()) != 0)
+		{
+			::close(new_fd);
+			::unlink(tmp_path.c_str());
+			return;
+		}
+
+		::close(fd_);
+		fd_ = new_fd;
+		disk_index_ = std::move(new_index);
+		write_offset_ = new_offset;
+		live_bytes_ = new_offset;
+	}
+
+	// 在内存层插入新条目，必要时把最旧的条目溢出到磁盘
+	void insert_front(const string& key, string value)
+	{
+		if (cache_list_.size() >= capacity_)
+		{
+			CacheNode& victim = cache_list_.back();
+			spill(victim.first, victim.second);
+			key_to_iter_.erase(victim.first);
+			cache_list_.pop_back();
+		}
+
+		cache_list_.emplace_front(key, std::move(value));
+		key_to_iter_[key] = cache_list_.begin();
+	}
+
+public:
+	// segment_path 为空时不启用第二级；段文件打不开时抛出 runtime_error，不会悄悄退化成纯内存缓存
+	TieredLRUCache(size_t capacity, const string& segment_path, uint64_t disk_budget)
+		: capacity_(capacity), segment_path_(segment_path), disk_budget_(disk_budget)
+	{
+		if (!segment_path_.empty())
+		{
+			fd_ = ::open(segment_path_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+			if (fd_ < 0)
+			{
+				throw runtime_error("open " + segment_path_ + ": " + strerror(errno));
+			}
+		}
+	}
+
+	~TieredLRUCache()
+	{
+		if (fd_ >= 0)
+		{
+			::close(fd_);
+			::unlink(segment_path_.c_str());
+		}
+	}
+
+	// 禁用拷贝构造和赋值运算符
+	TieredLRUCache(const TieredLRUCache& other) = delete;
+	TieredLRUCache& operator=(const TieredLRUCache& other) = delete;
+
+	// 查询：先查内存，再查磁盘；磁盘命中则提升到内存层
+	optional<string> get(const string& key)
+	{
+		auto it = key_to_iter_.find(key);
+		if (it != key_to_iter_.end())
+		{
+			cache_list_.splice(cache_list_.begin(), cache_list_, it->second);
+			return it->second->second;
+		}
+
+		auto disk = disk_index_.find(key);
+		if (disk == disk_index_.end() || capacity_ == 0)
+		{
+			return nullopt;
+		}
+
+		string value(disk->second.value_len, '\0');
+		if (!pread_all(fd_, value.data(), value.size(), disk->second.offset))
+		{
+			drop_from_disk(key);
+			return nullopt;
+		}
+
+		disk_hits_++;
+		drop_from_disk(key);
+		insert_front(key, value);
+		return value;
+	}
+
+	// 存入：写入内存层；磁盘上的旧版本作废
+	void put(const string& key, string value)
+	{
+		auto it = key_to_iter_.find(key);
+		if (it != key_to_iter_.end())
+		{
+			it->second->second = std::move(value);
+			cache_list_.splice(cache_list_.begin(), cache_list_, it->second);
+			return;
+		}
+
+		if (capacity_ == 0)
+		{
+			return;
+		}
+
+		drop_from_disk(key);
+		insert_front(key, std::move(value));
+	}
+
+	size_t memory_size() const noexcept
+	{
+		return cache_list_.size();
+	}
+
+	size_t disk_size() const noexcept
+	{
+		return disk_index_.size();
+	}
+
+	size_t disk_hits() const noexcept
+	{
+		return disk_hits_;
+	}
+
+	uint64_t disk_bytes() const noexcept
+	{
+		return write_offset_;
+	}
+};
+
+int main()
+{
+	// 内存层 1000 条，磁盘预算 16 MB；工作集 10000 个 key，每个 value 1 KB
+	const size_t memory_capacity = 1000;
+	const int working_set = 10000;
+	optional<TieredLRUCache> tiered;
+	try
+	{
+		tiered.emplace(memory_capacity, "lru_tier2.seg", 16 << 20);
+	}
+	catch (const exception& e)
+	{
+		cerr << e.what() << "\n";
+		return 1;
+	}
+	TieredLRUCache& cache = *tiered;
+
+	mt19937 gen(3);
+	uniform_int_distribution<int> dis(0, working_set - 1);
+	size_t backend_calls = 0;
+	const int requests = 200000;
+
+	for (int i = 0; i < requests; i++)
+	{
+		string key = "item:" + to_string(dis(gen));
+		if (!cache.get(key))
+		{
+			backend_calls++;
+			cache.put(key, string(1024, static_cast<char>('a' + key.size() % 26)));
+		}
+	}
+
+	cout << "请求 " << requests << " 次，回源 " << backend_calls << " 次，磁盘命中 " << cache.disk_hits() << " 次\n";
+	cout << "内存条目 " << cache.memory_size() << "，磁盘条目 " << cache.disk_size()
+		 << "，段文件 " << (cache.disk_bytes() >> 10) << " KB\n";
+
+	return 0;
+}
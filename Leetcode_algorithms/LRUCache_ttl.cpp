@@ -0,0 +1,458 @@
+#include <iostream>
+#include <list>
+#include <unordered_map>
+#include <string>
+#include <chrono>
+#include <cstdint>
+
+using namespace std;
+
+/*
+ * LeetCode 146: LRU 缓存 —— 按字节计容量 + TTL 过期
+ * 原版按条目数计容量 (cache_list_.size() >= capacity_)，value 从 16 字节到 1 MB 不等时，内存占用无法预估
+ * 改进：
+ * (1) 每个条目带权重（默认 = key + value + 节点开销的字节数），总权重不超过字节预算，超出时从 LRU 尾部淘汰
+ * (2) 每个条目可设置 TTL，由分层时间轮负责过期：插入/删除 O(1)，推进时间轮均摊 O(1)，不需要周期性全表扫描
+ */
+
+// 分层时间轮：4 层，每层 64 个槽，第 L 层的一个槽覆盖 64^L 个 tick
+// 到期时间较远的定时器先挂在高层，随着时间推进逐层“降级”(cascade) 到第 0 层，在第 0 层触发
+class TimingWheel
+{
+public:
+	// 侵入式定时器节点：由使用者嵌入自己的结构体中，避免额外分配
+	struct TimerNode
+	{
+		TimerNode* prev = nullptr;
+		TimerNode* next = nullptr;
+		uint64_t expire_tick = 0;
+		uint32_t slot_index = 0;		// 所在槽位：level * SLOTS + slot
+
+		bool linked() const noexcept
+		{
+			return next != nullptr;
+		}
+	};
+
+private:
+	static constexpr int LEVELS = 4;
+	static constexpr int SLOT_BITS = 6;
+	static constexpr uint64_t SLOTS = 1 << SLOT_BITS;
+	static constexpr uint64_t SLOT_MASK = SLOTS - 1;
+
+	// 每个槽是一个带哨兵的循环双向链表
+	TimerNode slots_[LEVELS][SLOTS];
+	// 每层一个 64 位占用位图：第 i 位为 1 表示第 i 个槽非空，用于直接跳到下一个有定时器的时刻
+	uint64_t occupied_[LEVELS] = {};
+	uint64_t current_tick_;
+	size_t count_ = 0;
+
+	void link(int level, uint64_t slot, TimerNode* node) noexcept
+	{
+		TimerNode& head = slots_[level][slot];
+		node->prev = &head;
+		node->next = head.next;
+		head.next->prev = node;
+		head.next = node;
+		node->slot_index = static_cast<uint32_t>(level * SLOTS + slot);
+		occupied_[level] |= uint64_t(1) << slot;
+	}
+
+	void unlink(TimerNode* node) noexcept
+	{
+		node->prev->next = node->next;
+		node->next->prev = node->prev;
+		node->prev = node->next = nullptr;
+
+		int level = static_cast<int>(node->slot_index / SLOTS);
+		uint64_t slot = node->slot_index & SLOT_MASK;
+		TimerNode& head = slots_[level][slot];
+		if (head.next == &head)
+		{
+			occupied_[level] &= ~(uint64_t(1) << slot);
+		}
+	}
+
+	// 按剩余 tick 数选择层级和槽位；earliest 为最早可触发的 tick
+	// 新定时器至少等到下一个 tick，降级中的定时器可以落在当前 tick（随后在同一 tick 触发）
+	void place(TimerNode* node, uint64_t earliest) noexcept
+	{
+		uint64_t expire = max(node->expire_tick, earliest);
+		uint64_t delta = expire - current_tick_;
+
+		int level = 0;
+		while (level < LEVELS - 1 && delta >= (SLOTS << (SLOT_BITS * level)))
+		{
+			level++;
+		}
+
+		// 超出最高层范围的定时器挂在最高层最远的槽，触发时再重新安排
+		uint64_t max_delta = (SLOTS << (SLOT_BITS * level)) - 1;
+		if (delta > max_delta)
+		{
+			expire = current_tick_ + max_delta;
+		}
+
+		uint64_t slot = (expire >> (SLOT_BITS * level)) & SLOT_MASK;
+		link(level, slot, node);
+	}
+
+	// 下一个需要处理的 tick：第 0 层某个非空槽到期，或高层某个非空槽需要降级
+	// 第 L 层的槽 s 只在低位全为 0、第 L 位等于 s 的时刻被处理；s 不大于当前位时要等到本层转完一圈
+	// 时间轮为空时返回 UINT64_MAX
+	uint64_t next_event_tick() const noexcept
+	{
+		uint64_t next = UINT64_MAX;
+		for (int level = 0; level < LEVELS; level++)
+		{
+			if (occupied_[level] == 0)
+			{
+				continue;
+			}
+
+			int shift = SLOT_BITS * level;
+			uint64_t digit = (current_tick_ >> shift) & SLOT_MASK;
+			uint64_t rotation = (current_tick_ >> (shift + SLOT_BITS)) << (shift + SLOT_BITS);
+			uint64_t later = digit == SLOT_MASK ? 0 : occupied_[level] & (~uint64_t(0) << (digit + 1));
+
+			uint64_t tick;
+			if (later != 0)
+			{
+				tick = rotation + (uint64_t(__builtin_ctzll(later)) << shift);
+			}
+			else
+			{
+				tick = rotation + (uint64_t(1) << (shift + SLOT_BITS)) + (uint64_t(__builtin_ctzll(occupied_[level])) << shift);
+			}
+			next = min(next, tick);
+		}
+		return next;
+	}
+
+	// 把第 level 层当前槽里的定时器全部重新安排到更低的层
+	void cascade(int level) noexcept
+	{
+		uint64_t slot = (current_tick_ >> (SLOT_BITS * level)) & SLOT_MASK;
+		TimerNode& head = slots_[level][slot];
+		while (head.next != &head)
+		{
+			TimerNode* node = head.next;
+			unlink(node);
+			place(node, current_tick_);
+		}
+	}
+
+public:
+	explicit TimingWheel(uint64_t start_tick = 0) : current_tick_(start_tick)
+	{
+		for (auto& level : slots_)
+		{
+			for (auto& head : level)
+			{
+				head.prev = head.next = &head;
+			}
+		}
+	}
+
+	// 哨兵节点互相指向，不可拷贝/移动
+	TimingWheel(const TimingWheel& other) = delete;
+	TimingWheel& operator=(const TimingWheel& other) = delete;
+
+	void schedule(TimerNode* node, uint64_t expire_tick) noexcept
+	{
+		if (node->linked())
+		{
+			unlink(node);
+			count_--;
+		}
+		node->expire_tick = expire_tick;
+		place(node, current_tick_ + 1);
+		count_++;
+	}
+
+	void cancel(TimerNode* node) noexcept
+	{
+		if (node->linked())
+		{
+			unlink(node);
+			count_--;
+		}
+	}
+
+	// 推进到 now_tick，对每个到期节点调用 on_expire(node)
+	// on_expire 中可以安全地释放该节点
+	// 借助占用位图直接跳到下一个非空槽（或降级时刻），中间的空槽不逐 tick 空转：
+	// 每次循环要么处理至少一个非空槽，要么到达 now_tick，长时间空闲后也只需少量几步
+	template<typename F>
+	void advance(uint64_t now_tick, F&& on_expire)
+	{
+		while (current_tick_ < now_tick)
+		{
+			current_tick_ = min(now_tick, next_event_tick());
+
+			// 第 0 层转满一圈，从高层依次降级
+			if ((current_tick_ & SLOT_MASK) == 0)
+			{
+				int level = 1;
+				while (level < LEVELS && ((current_tick_ >> (SLOT_BITS * (level - 1))) & SLOT_MASK) == 0)
+				{
+					level++;
+				}
+				for (int l = level - 1; l >= 1; l--)
+				{
+					cascade(l);
+				}
+			}
+
+			TimerNode& head = slots_[0][current_tick_ & SLOT_MASK];
+			while (head.next != &head)
+			{
+				TimerNode* node = head.next;
+				unlink(node);
+				count_--;
+
+				// 被截断过的远期定时器尚未真正到期，重新安排
+				if (node->expire_tick > current_tick_)
+				{
+					place(node, current_tick_ + 1);
+					count_++;
+					continue;
+				}
+				on_expire(node);
+			}
+		}
+	}
+
+	uint64_t current_tick() const noexcept
+	{
+		return current_tick_;
+	}
+
+	size_t size() const noexcept
+	{
+		return count_;
+	}
+};
+
+template<typename Clock = chrono::steady_clock>
+class WeightedTTLCache
+{
+	// 条目：继承定时器节点，时间轮触发时可以直接转换回条目
+	struct Entry : TimingWheel::TimerNode
+	{
+		string key;
+		string value;
+		size_t weight;
+		bool has_ttl;
+	};
+
+	using ListIter = typename list<Entry>::iterator;
+
+	size_t byte_budget_;
+	size_t total_weight_ = 0;
+	chrono::nanoseconds tick_;
+	typename Clock::time_point epoch_;
+
+	// 双向链表
+	list<Entry> cache_list_;
+
+	// 哈希表
+	unordered_map<string, ListIter> key_to_iter_;
+
+	TimingWheel wheel_;
+
+	uint64_t now_tick() const
+	{
+		return static_cast<uint64_t>((Clock::now() - epoch_) / tick_);
+	}
+
+	void erase_iter(ListIter it)
+	{
+		wheel_.cancel(&*it);
+		total_weight_ -= it->weight;
+		key_to_iter_.erase(it->key);
+		cache_list_.erase(it);
+	}
+
+	// 推进时间轮，删除所有已到期的条目
+	void expire(uint64_t now)
+	{
+		wheel_.advance(now, [this](TimingWheel::TimerNode* node)
+		{
+			Entry* e = static_cast<Entry*>(node);
+			erase_iter(key_to_iter_.find(e->key)->second);
+		});
+	}
+
+	// 条目的默认权重：key 和 value 的字节数，加上链表节点和哈希表节点的大致开销
+	static size_t default_weight(const string& key, const string& value)
+	{
+		return key.size() + value.size() + sizeof(Entry) + sizeof(pair<const string, ListIter>) + 2 * sizeof(void*);
+	}
+
+public:
+	explicit WeightedTTLCache(size_t byte_budget, chrono::nanoseconds tick = chrono::milliseconds(1))
+		: byte_budget_(byte_budget), tick_(tick), epoch_(Clock::now())
+	{
+
+	}
+
+	// 禁用拷贝构造和赋值运算符
+	WeightedTTLCache(const WeightedTTLCache& other) = delete;
+	WeightedTTLCache& operator=(const WeightedTTLCache& other) = delete;
+
+	// 查询：返回 value 的指针，未命中或已过期返回 nullptr
+	const string* get(const string& key)
+	{
+		uint64_t now = now_tick();
+		expire(now);
+
+		auto it = key_to_iter_.find(key);
+		if (it == key_to_iter_.end())
+		{
+			return nullptr;
+		}
+
+		cache_list_.splice(cache_list_.begin(), cache_list_, it->second);
+		return &it->second->value;
+	}
+
+	// 存入：ttl 为 0 表示永不过期；weight 为 0 表示使用默认权重
+	// 单个条目超过整个预算时拒绝存入，返回 false
+	bool put(const string& key, string value, chrono::nanoseconds ttl = chrono::nanoseconds::zero(), size_t weight = 0)
+	{
+		uint64_t now = now_tick();
+		expire(now);
+
+		if (weight == 0)
+		{
+			weight = default_weight(key, value);
+		}
+		if (weight > byte_budget_)
+		{
+			erase(key);
+			return false;
+		}
+
+		auto it = key_to_iter_.find(key);
+		if (it != key_to_iter_.end())
+		{
+			// 更新：先把旧条目的权重扣除
+			total_weight_ -= it->second->weight;
+			cache_list_.splice(cache_list_.begin(), cache_list_, it->second);
+		}
+		else
+		{
+			cache_list_.emplace_front();
+			cache_list_.front().key = key;
+			key_to_iter_[key] = cache_list_.begin();
+		}
+
+		Entry& e = cache_list_.front();
+		e.value = std::move(value);
+		e.weight = weight;
+		e.has_ttl = ttl > chrono::nanoseconds::zero();
+		total_weight_ += weight;
+
+		// 至少存活到下一个 tick 之后，避免刚写入就被判定过期
+		if (e.has_ttl)
+		{
+			uint64_t ticks = static_cast<uint64_t>((ttl + tick_ - chrono::nanoseconds(1)) / tick_);
+			wheel_.schedule(&e, now + max<uint64_t>(ticks, 1));
+		}
+		else
+		{
+			wheel_.cancel(&e);
+		}
+
+		// 超出预算，从最旧的条目开始淘汰（新条目位于表头，不会被淘汰）
+		while (total_weight_ > byte_budget_)
+		{
+			erase_iter(prev(cache_list_.end()));
+		}
+		return true;
+	}
+
+	bool erase(const string& key)
+	{
+		auto it = key_to_iter_.find(key);
+		if (it == key_to_iter_.end())
+		{
+			return false;
+		}
+		erase_iter(it->second);
+		return true;
+	}
+
+	size_t size() const noexcept
+	{
+		return cache_list_.size();
+	}
+
+	size_t weight() const noexcept
+	{
+		return total_weight_;
+	}
+
+	size_t byte_budget() const noexcept
+	{
+		return byte_budget_;
+	}
+};
+
+// 演示代码：定义 LRU_CACHE_NO_DEMO 后可 #include 本文件复用 TimingWheel / WeightedTTLCache
+#ifndef LRU_CACHE_NO_DEMO
+
+// 演示用的手动时钟，便于观察过期
+struct ManualClock
+{
+	using duration = chrono::nanoseconds;
+	using rep = duration::rep;
+	using period = duration::period;
+	using time_point = chrono::time_point<ManualClock>;
+	static constexpr bool is_steady = true;
+
+	static inline time_point current{};
+
+	static time_point now() noexcept
+	{
+		return current;
+	}
+
+	static void sleep(duration d) noexcept
+	{
+		current += d;
+	}
+};
+
+int main()
+{
+	// 1. 字节预算：1 MB，写入大小从 16 字节到 256 KB 不等的 value
+	WeightedTTLCache<> weighted(1 << 20);
+	for (int i = 0; i < 64; i++)
+	{
+		size_t len = size_t(16) << (i % 15);
+		weighted.put("blob:" + to_string(i), string(len, 'x'));
+	}
+	cout << "条目数: " << weighted.size() << ", 占用: " << weighted.weight() << " / " << weighted.byte_budget() << " 字节\n";
+
+	// 2. TTL：使用手动时钟推进时间
+	WeightedTTLCache<ManualClock> ttl_cache(1 << 20);
+	ttl_cache.put("session", "abc", chrono::milliseconds(100));
+	ttl_cache.put("config", "v1", chrono::hours(3));
+	ttl_cache.put("static", "forever");
+
+	ManualClock::sleep(chrono::milliseconds(50));
+	cout << "50ms 后 session: " << (ttl_cache.get("session") ? "存在" : "已过期") << "\n";
+
+	ManualClock::sleep(chrono::milliseconds(60));
+	cout << "110ms 后 session: " << (ttl_cache.get("session") ? "存在" : "已过期") << "\n";
+
+	ManualClock::sleep(chrono::hours(3));
+	cout << "3 小时后 config: " << (ttl_cache.get("config") ? "存在" : "已过期")
+		 << ", static: " << (ttl_cache.get("static") ? "存在" : "已过期") << "\n";
+
+	return 0;
+}
+
+#endif // LRU_CACHE_NO_DEMO
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+
+/*
+ * LRUCache 各演示 / 基准共用的 Zipf 分布 key 生成器
+ * 被 LRUCache_sharded.cpp、LRUCache_policies.cpp 和 LRUCache_benchmark.cpp 共同 #include，只保留这一份定义
+ * 预先计算累积分布，二分查找采样；返回 [0, n) 内的 key，key 越小越热
+ */
+class ZipfGenerator
+{
+	std::vector<double> cdf_;
+
+public:
+	ZipfGenerator(size_t n, double theta)
+	{
+		cdf_.resize(n);
+		double sum = 0;
+		for (size_t i = 0; i < n; i++)
+		{
+			sum += 1.0 / std::pow(static_cast<double>(i + 1), theta);
+			cdf_[i] = sum;
+		}
+		for (auto& c : cdf_)
+		{
+			c /= sum;
+		}
+	}
+
+	int operator()(std::mt19937_64& gen) const
+	{
+		double u = std::uniform_real_distribution<double>(0.0, 1.0)(gen);
+		return static_cast<int>(std::lower_bound(cdf_.begin(), cdf_.end(), u) - cdf_.begin());
+	}
+};
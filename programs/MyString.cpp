@@ -2,100 +2,1213 @@
 #include<stdexcept>
 #include<memory>
 #include<utility>
+#include<cstring>
+#include<string_view>
+#include<algorithm>
+#include<memory_resource>
+#include<string>
+#include<cstdint>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define STRING_KERNELS_X86 1
+#include<immintrin.h>
+#endif
+
+// 字符串扫描内核：按 CPU 能力在运行时选择实现
+// (1) Scalar：可移植的后备实现，能交给 libc 的（memchr / strlen）直接交给 libc
+// (2) SSE2：x86-64 的基线，每次比较 16 字节
+// (3) AVX2：运行时检测到才启用，每次比较 32 字节
+// 子串查找用“首尾字节过滤”：同时比较候选位置的首字节和尾字节，两者都匹配的位置才做一次 memcmp
+namespace string_kernels
+{
+    constexpr size_t npos = static_cast<size_t>(-1);
+
+    enum class SimdLevel { Scalar, SSE2, AVX2 };
+
+    // ---------------------------------------------------------------------
+    // Scalar
+    // ---------------------------------------------------------------------
+    inline size_t find_char_scalar(const char* s, size_t n, char c) noexcept
+    {
+        const void* p = n ? std::memchr(s, c, n) : nullptr;
+        return p ? static_cast<size_t>(static_cast<const char*>(p) - s) : npos;
+    }
+
+    // 第一个不同字节的下标，完全相同返回 n
+    inline size_t mismatch_scalar(const char* a, const char* b, size_t n) noexcept
+    {
+        size_t i = 0;
+        while (i < n && a[i] == b[i])
+        {
+            i++;
+        }
+        return i;
+    }
+
+    // 调用方保证 2 <= m <= n
+    inline size_t find_substr_scalar(const char* h, size_t n, const char* nd, size_t m) noexcept
+    {
+        for (size_t i = 0; i + m <= n; i++)
+        {
+            size_t k = find_char_scalar(h + i, n - m + 1 - i, nd[0]);
+            if (k == npos)
+            {
+                return npos;
+            }
+            i += k;
+            if (std::memcmp(h + i + 1, nd + 1, m - 1) == 0)
+            {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    inline size_t length_scalar(const char* s) noexcept
+    {
+        return std::strlen(s);
+    }
+
+#ifdef STRING_KERNELS_X86
+    // 长度扫描按对齐块读取，可能读到字符串开头之前、结尾之后的同一对齐块内的字节
+    // 对齐块不会跨页，硬件上是安全的，但 AddressSanitizer 会误报，因此对这两个函数关闭检测
+#define STRING_KERNELS_NO_ASAN __attribute__((no_sanitize_address))
+
+    // ---------------------------------------------------------------------
+    // SSE2
+    // ---------------------------------------------------------------------
+    inline size_t find_char_sse2(const char* s, size_t n, char c) noexcept
+    {
+        const __m128i target = _mm_set1_epi8(c);
+        size_t i = 0;
+
+        // 每轮 64 字节：四个块的比较结果先 OR 起来，只有命中时才逐块定位，减少分支
+        for (; i + 64 <= n; i += 64)
+        {
+            const __m128i* p = reinterpret_cast<const __m128i*>(s + i);
+            __m128i e0 = _mm_cmpeq_epi8(_mm_loadu_si128(p), target);
+            __m128i e1 = _mm_cmpeq_epi8(_mm_loadu_si128(p + 1), target);
+            __m128i e2 = _mm_cmpeq_epi8(_mm_loadu_si128(p + 2), target);
+            __m128i e3 = _mm_cmpeq_epi8(_mm_loadu_si128(p + 3), target);
+            if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(e0, e1), _mm_or_si128(e2, e3))))
+            {
+                uint64_t mask = static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(e0)))
+                    | static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(e1))) << 16
+                    | static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(e2))) << 32
+                    | static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(e3))) << 48;
+                return i + __builtin_ctzll(mask);
+            }
+        }
+
+        for (; i + 16 <= n; i += 16)
+        {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, target)));
+            if (mask)
+            {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        for (; i < n; i++)
+        {
+            if (s[i] == c)
+            {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    inline size_t mismatch_sse2(const char* a, const char* b, size_t n) noexcept
+    {
+        size_t i = 0;
+
+        // 每轮 64 字节：四个块全部相等才继续，否则交给下面的单块循环定位
+        for (; i + 64 <= n; i += 64)
+        {
+            const __m128i* pa = reinterpret_cast<const __m128i*>(a + i);
+            const __m128i* pb = reinterpret_cast<const __m128i*>(b + i);
+            __m128i e01 = _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128(pa), _mm_loadu_si128(pb)),
+                                        _mm_cmpeq_epi8(_mm_loadu_si128(pa + 1), _mm_loadu_si128(pb + 1)));
+            __m128i e23 = _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128(pa + 2), _mm_loadu_si128(pb + 2)),
+                                        _mm_cmpeq_epi8(_mm_loadu_si128(pa + 3), _mm_loadu_si128(pb + 3)));
+            if (_mm_movemask_epi8(_mm_and_si128(e01, e23)) != 0xFFFF)
+            {
+                break;
+            }
+        }
+
+        for (; i + 16 <= n; i += 16)
+        {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb))) ^ 0xFFFFu;
+            if (mask)
+            {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        return i + mismatch_scalar(a + i, b + i, n - i);
+    }
+
+    inline size_t find_substr_sse2(const char* h, size_t n, const char* nd, size_t m) noexcept
+    {
+        const __m128i first = _mm_set1_epi8(nd[0]);
+        const __m128i last = _mm_set1_epi8(nd[m - 1]);
+        size_t i = 0;
+
+        // 一次检查 16 个候选起点 i..i+15：首字节块从 h+i 读，尾字节块从 h+i+m-1 读
+        for (; i + m - 1 + 16 <= n; i += 16)
+        {
+            __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i));
+            __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i + m - 1));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+                _mm_and_si128(_mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last))));
+            while (mask)
+            {
+                size_t pos = i + __builtin_ctz(mask);
+                if (std::memcmp(h + pos + 1, nd + 1, m - 2) == 0)
+                {
+                    return pos;
+                }
+                mask &= mask - 1;
+            }
+        }
+
+        size_t rest = find_substr_scalar(h + i, n - i, nd, m);
+        return rest == npos ? npos : i + rest;
+    }
+
+    STRING_KERNELS_NO_ASAN inline size_t length_sse2(const char* s) noexcept
+    {
+        const __m128i zero = _mm_setzero_si128();
+        size_t misalign = reinterpret_cast<uintptr_t>(s) & 15;
+        const char* block = s - misalign;
+
+        // 第一块丢掉字符串开头之前的字节
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_cmpeq_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(block)), zero))) >> misalign;
+        if (mask)
+        {
+            return __builtin_ctz(mask);
+        }
+
+        for (;;)
+        {
+            block += 16;
+            mask = static_cast<unsigned>(_mm_movemask_epi8(
+                _mm_cmpeq_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(block)), zero)));
+            if (mask)
+            {
+                return static_cast<size_t>(block - s) + __builtin_ctz(mask);
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------
+    // AVX2：与 SSE2 版本逻辑相同，块宽 32 字节
+    // ---------------------------------------------------------------------
+    __attribute__((target("avx2"))) inline size_t find_char_avx2(const char* s, size_t n, char c) noexcept
+    {
+        const __m256i target = _mm256_set1_epi8(c);
+        size_t i = 0;
+
+        for (; i + 128 <= n; i += 128)
+        {
+            const __m256i* p = reinterpret_cast<const __m256i*>(s + i);
+            __m256i e0 = _mm256_cmpeq_epi8(_mm256_loadu_si256(p), target);
+            __m256i e1 = _mm256_cmpeq_epi8(_mm256_loadu_si256(p + 1), target);
+            __m256i e2 = _mm256_cmpeq_epi8(_mm256_loadu_si256(p + 2), target);
+            __m256i e3 = _mm256_cmpeq_epi8(_mm256_loadu_si256(p + 3), target);
+            if (!_mm256_testz_si256(_mm256_or_si256(e0, e1), _mm256_or_si256(e0, e1))
+                || !_mm256_testz_si256(_mm256_or_si256(e2, e3), _mm256_or_si256(e2, e3)))
+            {
+                uint64_t lo = static_cast<uint64_t>(static_cast<unsigned>(_mm256_movemask_epi8(e0)))
+                    | static_cast<uint64_t>(static_cast<unsigned>(_mm256_movemask_epi8(e1))) << 32;
+                if (lo)
+                {
+                    return i + __builtin_ctzll(lo);
+                }
+                uint64_t hi = static_cast<uint64_t>(static_cast<unsigned>(_mm256_movemask_epi8(e2)))
+                    | static_cast<uint64_t>(static_cast<unsigned>(_mm256_movemask_epi8(e3))) << 32;
+                return i + 64 + __builtin_ctzll(hi);
+            }
+        }
+
+        for (; i + 32 <= n; i += 32)
+        {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, target)));
+            if (mask)
+            {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        size_t rest = find_char_sse2(s + i, n - i, c);
+        return rest == npos ? npos : i + rest;
+    }
+
+    __attribute__((target("avx2"))) inline size_t mismatch_avx2(const char* a, const char* b, size_t n) noexcept
+    {
+        size_t i = 0;
+
+        for (; i + 128 <= n; i += 128)
+        {
+            const __m256i* pa = reinterpret_cast<const __m256i*>(a + i);
+            const __m256i* pb = reinterpret_cast<const __m256i*>(b + i);
+            __m256i d01 = _mm256_or_si256(_mm256_xor_si256(_mm256_loadu_si256(pa), _mm256_loadu_si256(pb)),
+                                          _mm256_xor_si256(_mm256_loadu_si256(pa + 1), _mm256_loadu_si256(pb + 1)));
+            __m256i d23 = _mm256_or_si256(_mm256_xor_si256(_mm256_loadu_si256(pa + 2), _mm256_loadu_si256(pb + 2)),
+                                          _mm256_xor_si256(_mm256_loadu_si256(pa + 3), _mm256_loadu_si256(pb + 3)));
+            __m256i diff = _mm256_or_si256(d01, d23);
+            if (!_mm256_testz_si256(diff, diff))
+            {
+                break;
+            }
+        }
+
+        for (; i + 32 <= n; i += 32)
+        {
+            __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb)));
+            if (mask)
+            {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        return i + mismatch_sse2(a + i, b + i, n - i);
+    }
+
+    __attribute__((target("avx2"))) inline size_t find_substr_avx2(const char* h, size_t n, const char* nd, size_t m) noexcept
+    {
+        const __m256i first = _mm256_set1_epi8(nd[0]);
+        const __m256i last = _mm256_set1_epi8(nd[m - 1]);
+        size_t i = 0;
+
+        for (; i + m - 1 + 32 <= n; i += 32)
+        {
+            __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(h + i));
+            __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(h + i + m - 1));
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+                _mm256_and_si256(_mm256_cmpeq_epi8(block_first, first), _mm256_cmpeq_epi8(block_last, last))));
+            while (mask)
+            {
+                size_t pos = i + __builtin_ctz(mask);
+                if (std::memcmp(h + pos + 1, nd + 1, m - 2) == 0)
+                {
+                    return pos;
+                }
+                mask &= mask - 1;
+            }
+        }
+
+        size_t rest = find_substr_sse2(h + i, n - i, nd, m);
+        return rest == npos ? npos : i + rest;
+    }
+
+    __attribute__((target("avx2"))) STRING_KERNELS_NO_ASAN inline size_t length_avx2(const char* s) noexcept
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        size_t misalign = reinterpret_cast<uintptr_t>(s) & 31;
+        const char* block = s - misalign;
+
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_load_si256(reinterpret_cast<const __m256i*>(block)), zero))) >> misalign;
+        if (mask)
+        {
+            return __builtin_ctz(mask);
+        }
+
+        // 先逐块前进到 128 字节对齐，之后每轮读 4 个对齐块（同样不会跨页）
+        block += 32;
+        for (; reinterpret_cast<uintptr_t>(block) & 127; block += 32)
+        {
+            mask = static_cast<unsigned>(_mm256_movemask_epi8(
+                _mm256_cmpeq_epi8(_mm256_load_si256(reinterpret_cast<const __m256i*>(block)), zero)));
+            if (mask)
+            {
+                return static_cast<size_t>(block - s) + __builtin_ctz(mask);
+            }
+        }
+
+        for (;; block += 128)
+        {
+            const __m256i* p = reinterpret_cast<const __m256i*>(block);
+            __m256i m01 = _mm256_min_epu8(_mm256_load_si256(p), _mm256_load_si256(p + 1));
+            __m256i m23 = _mm256_min_epu8(_mm256_load_si256(p + 2), _mm256_load_si256(p + 3));
+            if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(m01, m23), zero)))
+            {
+                break;
+            }
+        }
+
+        for (;; block += 32)
+        {
+            mask = static_cast<unsigned>(_mm256_movemask_epi8(
+                _mm256_cmpeq_epi8(_mm256_load_si256(reinterpret_cast<const __m256i*>(block)), zero)));
+            if (mask)
+            {
+                return static_cast<size_t>(block - s) + __builtin_ctz(mask);
+            }
+        }
+    }
+#endif // STRING_KERNELS_X86
+
+    // ---------------------------------------------------------------------
+    // UTF-8：校验、码点计数、以及转码时用到的 ASCII 前缀扫描
+    // Scalar 与 SSE2 对纯 ASCII 块走快速路径，其余逐个码点解码校验
+    // AVX2 使用 Keiser & Lemire 的查表法 ("Validating UTF-8 In Less Than One Instruction Per Byte")：
+    // 用 3 次 pshufb 查表同时检查每个字节与前一字节的组合，32 字节一块，无分支
+    // ---------------------------------------------------------------------
+
+    // 解码 s 开头的一个码点：合法时写入 cp 并返回字节数，非法返回 0
+    // 按 Unicode 表 3-7 检查：过长编码、代理区 U+D800..U+DFFF、超过 U+10FFFF、截断的序列
+    inline size_t decode_utf8(const unsigned char* s, size_t n, char32_t& cp) noexcept
+    {
+        unsigned char b0 = s[0];
+        if (b0 < 0x80)
+        {
+            cp = b0;
+            return 1;
+        }
+        if (b0 < 0xC2)
+        {
+            return 0;       // 孤立的后续字节，或 C0/C1 过长编码
+        }
+        if (b0 < 0xE0)
+        {
+            if (n < 2 || (s[1] & 0xC0) != 0x80)
+            {
+                return 0;
+            }
+            cp = (char32_t(b0 & 0x1F) << 6) | (s[1] & 0x3F);
+            return 2;
+        }
+        if (b0 < 0xF0)
+        {
+            unsigned char lo = (b0 == 0xE0) ? 0xA0 : 0x80;
+            unsigned char hi = (b0 == 0xED) ? 0x9F : 0xBF;
+            if (n < 3 || s[1] < lo || s[1] > hi || (s[2] & 0xC0) != 0x80)
+            {
+                return 0;
+            }
+            cp = (char32_t(b0 & 0x0F) << 12) | (char32_t(s[1] & 0x3F) << 6) | (s[2] & 0x3F);
+            return 3;
+        }
+        if (b0 < 0xF5)
+        {
+            unsigned char lo = (b0 == 0xF0) ? 0x90 : 0x80;
+            unsigned char hi = (b0 == 0xF4) ? 0x8F : 0xBF;
+            if (n < 4 || s[1] < lo || s[1] > hi || (s[2] & 0xC0) != 0x80 || (s[3] & 0xC0) != 0x80)
+            {
+                return 0;
+            }
+            cp = (char32_t(b0 & 0x07) << 18) | (char32_t(s[1] & 0x3F) << 12) | (char32_t(s[2] & 0x3F) << 6) | (s[3] & 0x3F);
+            return 4;
+        }
+        return 0;
+    }
+
+    // 开头连续 ASCII 字节的个数
+    inline size_t ascii_prefix_scalar(const char* s, size_t n) noexcept
+    {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, s + i, 8);
+            if (word & 0x8080808080808080ULL)
+            {
+                break;
+            }
+        }
+        while (i < n && static_cast<unsigned char>(s[i]) < 0x80)
+        {
+            i++;
+        }
+        return i;
+    }
+
+    inline bool validate_utf8_scalar(const char* s, size_t n) noexcept
+    {
+        const unsigned char* u = reinterpret_cast<const unsigned char*>(s);
+        size_t i = 0;
+        while (i < n)
+        {
+            i += ascii_prefix_scalar(s + i, n - i);
+            if (i == n)
+            {
+                break;
+            }
+            char32_t cp;
+            size_t len = decode_utf8(u + i, n - i, cp);
+            if (len == 0)
+            {
+                return false;
+            }
+            i += len;
+        }
+        return true;
+    }
+
+    // 码点个数 = 非后续字节 (10xxxxxx) 的个数；要求输入是合法的 UTF-8
+    inline size_t count_utf8_scalar(const char* s, size_t n) noexcept
+    {
+        size_t count = 0;
+        for (size_t i = 0; i < n; i++)
+        {
+            count += (static_cast<unsigned char>(s[i]) & 0xC0) != 0x80;
+        }
+        return count;
+    }
+
+#ifdef STRING_KERNELS_X86
+    inline size_t ascii_prefix_sse2(const char* s, size_t n) noexcept
+    {
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16)
+        {
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i))));
+            if (mask)
+            {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        return i + ascii_prefix_scalar(s + i, n - i);
+    }
+
+    inline bool validate_utf8_sse2(const char* s, size_t n) noexcept
+    {
+        const unsigned char* u = reinterpret_cast<const unsigned char*>(s);
+        size_t i = 0;
+        while (i < n)
+        {
+            i += ascii_prefix_sse2(s + i, n - i);
+            if (i == n)
+            {
+                break;
+            }
+            char32_t cp;
+            size_t len = decode_utf8(u + i, n - i, cp);
+            if (len == 0)
+            {
+                return false;
+            }
+            i += len;
+        }
+        return true;
+    }
+
+    inline size_t count_utf8_sse2(const char* s, size_t n) noexcept
+    {
+        // 有符号比较：后续字节 0x80..0xBF 即 -128..-65，其余字节都大于 -65
+        const __m128i threshold = _mm_set1_epi8(-65);
+        size_t count = 0;
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16)
+        {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+            count += __builtin_popcount(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi8(block, threshold))));
+        }
+        return count + count_utf8_scalar(s + i, n - i);
+    }
+
+    __attribute__((target("avx2"))) inline size_t ascii_prefix_avx2(const char* s, size_t n) noexcept
+    {
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32)
+        {
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i))));
+            if (mask)
+            {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        return i + ascii_prefix_sse2(s + i, n - i);
+    }
+
+    __attribute__((target("avx2"))) inline size_t count_utf8_avx2(const char* s, size_t n) noexcept
+    {
+        const __m256i threshold = _mm256_set1_epi8(-65);
+        size_t count = 0;
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32)
+        {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+            count += __builtin_popcount(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(block, threshold))));
+        }
+        return count + count_utf8_sse2(s + i, n - i);
+    }
+
+    // 当前块整体左移 N 字节，空出的位置由上一块的最后 N 个字节补上（即每个字节“前面第 N 个字节”）
+    template<int N>
+    __attribute__((target("avx2"))) inline __m256i utf8_prev_bytes(__m256i input, __m256i prev_input) noexcept
+    {
+        return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev_input, input, 0x21), 16 - N);
+    }
+
+    // 检查一个 32 字节块，返回非零表示有错误
+    __attribute__((target("avx2"))) inline __m256i utf8_check_block(__m256i input, __m256i prev_input) noexcept
+    {
+        // 错误类别，每类占一位；三张表分别按“前一字节高 4 位”“前一字节低 4 位”“当前字节高 4 位”查出可能的错误，三者相与即为确定的错误
+        constexpr char TOO_SHORT = 1 << 0;      // 11______ 0_______ 或 11______ 11______
+        constexpr char TOO_LONG = 1 << 1;       // 0_______ 10______
+        constexpr char OVERLONG_3 = 1 << 2;     // 11100000 100_____
+        constexpr char TOO_LARGE = 1 << 3;      // 11110100 1001____ 等，超过 U+10FFFF
+        constexpr char SURROGATE = 1 << 4;      // 11101101 101_____
+        constexpr char OVERLONG_2 = 1 << 5;     // 1100000_ 10______
+        constexpr char TOO_LARGE_1000 = 1 << 6; // 11110101 1000____ 等
+        constexpr char OVERLONG_4 = 1 << 6;     // 11110000 1000____
+        constexpr char TWO_CONTS = char(1 << 7);// 10______ 10______
+        constexpr char CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+        const __m256i byte_1_high_table = _mm256_setr_epi8(
+            TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+            TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+            TOO_SHORT | OVERLONG_2, TOO_SHORT, TOO_SHORT | OVERLONG_3 | SURROGATE,
+            TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4,
+            TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+            TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+            TOO_SHORT | OVERLONG_2, TOO_SHORT, TOO_SHORT | OVERLONG_3 | SURROGATE,
+            TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4);
+
+        const __m256i byte_1_low_table = _mm256_setr_epi8(
+            CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4, CARRY | OVERLONG_2, CARRY, CARRY,
+            CARRY | TOO_LARGE, CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE, CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4, CARRY | OVERLONG_2, CARRY, CARRY,
+            CARRY | TOO_LARGE, CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE, CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000);
+
+        const __m256i byte_2_high_table = _mm256_setr_epi8(
+            TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+            TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+            TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+            TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT);
+
+        const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+        __m256i prev1 = utf8_prev_bytes<1>(input, prev_input);
+        __m256i byte_1_high = _mm256_shuffle_epi8(byte_1_high_table, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble));
+        __m256i byte_1_low = _mm256_shuffle_epi8(byte_1_low_table, _mm256_and_si256(prev1, low_nibble));
+        __m256i byte_2_high = _mm256_shuffle_epi8(byte_2_high_table, _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble));
+        __m256i special = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+        // 前面第 2 / 第 3 个字节是 3 / 4 字节序列的首字节时，当前字节必须是后续字节
+        __m256i prev2 = utf8_prev_bytes<2>(input, prev_input);
+        __m256i prev3 = utf8_prev_bytes<3>(input, prev_input);
+        __m256i is_third_byte = _mm256_subs_epu8(prev2, _mm256_set1_epi8(char(0xE0 - 0x80)));
+        __m256i is_fourth_byte = _mm256_subs_epu8(prev3, _mm256_set1_epi8(char(0xF0 - 0x80)));
+        __m256i must_be_continuation = _mm256_and_si256(_mm256_or_si256(is_third_byte, is_fourth_byte), _mm256_set1_epi8(char(0x80)));
+
+        return _mm256_xor_si256(must_be_continuation, special);
+    }
+
+    // 块的最后 3 个字节中有未结束的多字节序列首字节时返回非零，需要由下一块补全
+    __attribute__((target("avx2"))) inline __m256i utf8_incomplete(__m256i input) noexcept
+    {
+        const __m256i max_value = _mm256_setr_epi8(
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, char(0xF0 - 1), char(0xE0 - 1), char(0xC0 - 1));
+        return _mm256_subs_epu8(input, max_value);
+    }
+
+    struct Utf8CheckState
+    {
+        __m256i error;
+        __m256i prev_input;
+        __m256i prev_incomplete;
+    };
+
+    __attribute__((target("avx2"))) inline void utf8_process_block(Utf8CheckState& st, __m256i input) noexcept
+    {
+        if (_mm256_movemask_epi8(input) == 0)
+        {
+            // 纯 ASCII 块：只需确认上一块没有以未完成的序列结尾
+            st.error = _mm256_or_si256(st.error, st.prev_incomplete);
+        }
+        else
+        {
+            st.error = _mm256_or_si256(st.error, utf8_check_block(input, st.prev_input));
+            st.prev_incomplete = utf8_incomplete(input);
+        }
+        st.prev_input = input;
+    }
+
+    __attribute__((target("avx2"))) inline bool validate_utf8_avx2(const char* s, size_t n) noexcept
+    {
+        Utf8CheckState st{_mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256()};
+
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32)
+        {
+            utf8_process_block(st, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i)));
+        }
+
+        // 尾部补 0（ASCII）凑满一块；末尾被截断的序列会在这一块中报 TOO_SHORT
+        alignas(32) char tail[32] = {};
+        std::memcpy(tail, s + i, n - i);
+        utf8_process_block(st, _mm256_load_si256(reinterpret_cast<const __m256i*>(tail)));
+        __m256i error = _mm256_or_si256(st.error, st.prev_incomplete);
+
+        return _mm256_testz_si256(error, error);
+    }
+#endif // STRING_KERNELS_X86
+
+    // ---------------------------------------------------------------------
+    // 运行时分发：首次使用时检测 CPU，选定一组函数指针
+    // ---------------------------------------------------------------------
+    struct KernelTable
+    {
+        SimdLevel level;
+        size_t (*find_char)(const char*, size_t, char) noexcept;
+        size_t (*mismatch)(const char*, const char*, size_t) noexcept;
+        size_t (*find_substr)(const char*, size_t, const char*, size_t) noexcept;
+        size_t (*length)(const char*) noexcept;
+        size_t (*ascii_prefix)(const char*, size_t) noexcept;
+        bool (*validate_utf8)(const char*, size_t) noexcept;
+        size_t (*count_utf8)(const char*, size_t) noexcept;
+    };
+
+    inline KernelTable make_table(SimdLevel level) noexcept
+    {
+#ifdef STRING_KERNELS_X86
+        if (level == SimdLevel::AVX2)
+        {
+            return KernelTable{level, find_char_avx2, mismatch_avx2, find_substr_avx2, length_avx2,
+                               ascii_prefix_avx2, validate_utf8_avx2, count_utf8_avx2};
+        }
+        if (level == SimdLevel::SSE2)
+        {
+            return KernelTable{level, find_char_sse2, mismatch_sse2, find_substr_sse2, length_sse2,
+                               ascii_prefix_sse2, validate_utf8_sse2, count_utf8_sse2};
+        }
+#endif
+        return KernelTable{SimdLevel::Scalar, find_char_scalar, mismatch_scalar, find_substr_scalar, length_scalar,
+                           ascii_prefix_scalar, validate_utf8_scalar, count_utf8_scalar};
+    }
+
+    // CPU 支持的最高级别
+    inline SimdLevel detect_level() noexcept
+    {
+#ifdef STRING_KERNELS_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return SimdLevel::AVX2;
+        }
+        if (__builtin_cpu_supports("sse2"))
+        {
+            return SimdLevel::SSE2;
+        }
+#endif
+        return SimdLevel::Scalar;
+    }
+
+    inline KernelTable& table() noexcept
+    {
+        static KernelTable t = make_table(detect_level());
+        return t;
+    }
+
+    // 强制使用指定级别（不超过 CPU 支持的级别），供测试和基准对比；不是线程安全的，须在使用字符串之前调用
+    inline SimdLevel use_level(SimdLevel level) noexcept
+    {
+        level = std::min(level, detect_level());
+        table() = make_table(level);
+        return table().level;
+    }
+
+    inline const char* level_name(SimdLevel level) noexcept
+    {
+        switch (level)
+        {
+            case SimdLevel::AVX2: return "AVX2";
+            case SimdLevel::SSE2: return "SSE2";
+            default: return "Scalar";
+        }
+    }
+
+    // ---------------------------------------------------------------------
+    // 对外接口：处理边界情况后转到当前级别的实现
+    // 短输入（标签、枚举值、路径、ID 等 64 字节以内的字符串）直接内联 memcmp / memchr：
+    // 查表 + 间接调用的固定开销比处理几十个字节本身还大，SIMD 分发只在输入足够长时划算
+    // ---------------------------------------------------------------------
+    constexpr size_t SHORT_INPUT = 64;
+
+    inline size_t find_char(const char* s, size_t n, char c) noexcept
+    {
+        if (n < SHORT_INPUT)
+        {
+            const void* p = n ? std::memchr(s, c, n) : nullptr;
+            return p ? static_cast<size_t>(static_cast<const char*>(p) - s) : npos;
+        }
+        return table().find_char(s, n, c);
+    }
+
+    inline size_t find(const char* h, size_t n, const char* nd, size_t m) noexcept
+    {
+        if (m == 0)
+        {
+            return 0;
+        }
+        if (m > n)
+        {
+            return npos;
+        }
+        if (m == 1)
+        {
+            return find_char(h, n, nd[0]);
+        }
+        if (n < SHORT_INPUT)
+        {
+            return find_substr_scalar(h, n, nd, m);
+        }
+        return table().find_substr(h, n, nd, m);
+    }
+
+    // 与 memcmp 相同的约定（按无符号字节比较），但长度不同时较短者在前
+    inline int compare(const char* a, size_t na, const char* b, size_t nb) noexcept
+    {
+        size_t n = std::min(na, nb);
+        if (n < SHORT_INPUT)
+        {
+            int r = n ? std::memcmp(a, b, n) : 0;
+            if (r != 0)
+            {
+                return r < 0 ? -1 : 1;
+            }
+            return na < nb ? -1 : (na > nb ? 1 : 0);
+        }
+        size_t k = table().mismatch(a, b, n);
+        if (k < n)
+        {
+            return static_cast<unsigned char>(a[k]) < static_cast<unsigned char>(b[k]) ? -1 : 1;
+        }
+        return na < nb ? -1 : (na > nb ? 1 : 0);
+    }
+
+    inline bool equal(const char* a, const char* b, size_t n) noexcept
+    {
+        if (n < SHORT_INPUT)
+        {
+            return n == 0 || std::memcmp(a, b, n) == 0;
+        }
+        return table().mismatch(a, b, n) == n;
+    }
+
+    inline size_t length(const char* s) noexcept
+    {
+        return table().length(s);
+    }
+
+    inline bool validate_utf8(const char* s, size_t n) noexcept
+    {
+        return table().validate_utf8(s, n);
+    }
+
+    inline size_t count_utf8(const char* s, size_t n) noexcept
+    {
+        return table().count_utf8(s, n);
+    }
+
+    // ---------------------------------------------------------------------
+    // 转码：ASCII 段用 SSE2 整块扩展 / 收窄（x86-64 基线，无需分发），其余逐个码点处理
+    // 输出缓冲区由调用方按最坏情况准备；输入非法时返回 npos
+    // ---------------------------------------------------------------------
+    template<typename CharT>
+    inline void widen_ascii(const unsigned char* s, size_t n, CharT* out) noexcept
+    {
+        size_t i = 0;
+#ifdef STRING_KERNELS_X86
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 16 <= n; i += 16)
+        {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+            __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+            __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+            if constexpr (sizeof(CharT) == 2)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), lo);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), hi);
+            }
+            else
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi16(lo, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4), _mm_unpackhi_epi16(lo, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), _mm_unpacklo_epi16(hi, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 12), _mm_unpackhi_epi16(hi, zero));
+            }
+        }
+#endif
+        for (; i < n; i++)
+        {
+            out[i] = static_cast<CharT>(s[i]);
+        }
+    }
+
+    // UTF-8 -> UTF-16 / UTF-32：out 至少容纳 n 个单元（每个输入字节最多产生一个单元）
+    template<typename CharT>
+    inline size_t utf8_to_utf(const char* s, size_t n, CharT* out) noexcept
+    {
+        const unsigned char* u = reinterpret_cast<const unsigned char*>(s);
+        size_t i = 0, k = 0;
+        while (i < n)
+        {
+            if (u[i] < 0x80)
+            {
+                size_t ascii = table().ascii_prefix(s + i, n - i);
+                widen_ascii(u + i, ascii, out + k);
+                i += ascii;
+                k += ascii;
+                continue;
+            }
+
+            char32_t cp;
+            size_t len = decode_utf8(u + i, n - i, cp);
+            if (len == 0)
+            {
+                return npos;
+            }
+            i += len;
+
+            if (sizeof(CharT) == 2 && cp >= 0x10000)
+            {
+                cp -= 0x10000;
+                out[k++] = static_cast<CharT>(0xD800 + (cp >> 10));
+                out[k++] = static_cast<CharT>(0xDC00 + (cp & 0x3FF));
+            }
+            else
+            {
+                out[k++] = static_cast<CharT>(cp);
+            }
+        }
+        return k;
+    }
+
+    inline size_t utf8_to_utf16(const char* s, size_t n, char16_t* out) noexcept
+    {
+        return utf8_to_utf(s, n, out);
+    }
+
+    inline size_t utf8_to_utf32(const char* s, size_t n, char32_t* out) noexcept
+    {
+        return utf8_to_utf(s, n, out);
+    }
+
+    // 把一个码点编码为 UTF-8，返回字节数；调用方保证 cp 合法
+    inline size_t encode_utf8(char32_t cp, char* out) noexcept
+    {
+        if (cp < 0x80)
+        {
+            out[0] = static_cast<char>(cp);
+            return 1;
+        }
+        if (cp < 0x800)
+        {
+            out[0] = static_cast<char>(0xC0 | (cp >> 6));
+            out[1] = static_cast<char>(0x80 | (cp & 0x3F));
+            return 2;
+        }
+        if (cp < 0x10000)
+        {
+            out[0] = static_cast<char>(0xE0 | (cp >> 12));
+            out[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out[2] = static_cast<char>(0x80 | (cp & 0x3F));
+            return 3;
+        }
+        out[0] = static_cast<char>(0xF0 | (cp >> 18));
+        out[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out[3] = static_cast<char>(0x80 | (cp & 0x3F));
+        return 4;
+    }
+
+    // UTF-16 -> UTF-8：out 至少容纳 3 * n 字节；不成对的代理项视为非法
+    inline size_t utf16_to_utf8(const char16_t* s, size_t n, char* out) noexcept
+    {
+        size_t i = 0, k = 0;
+        while (i < n)
+        {
+#ifdef STRING_KERNELS_X86
+            // 8 个单元都小于 0x80 时整块收窄
+            if (i + 8 <= n)
+            {
+                __m128i units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+                __m128i high = _mm_and_si128(units, _mm_set1_epi16(static_cast<short>(0xFF80)));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) == 0xFFFF)
+                {
+                    _mm_storel_epi64(reinterpret_cast<__m128i*>(out + k), _mm_packus_epi16(units, units));
+                    i += 8;
+                    k += 8;
+                    continue;
+                }
+            }
+#endif
+            char32_t cp = s[i++];
+            if (cp >= 0xD800 && cp <= 0xDFFF)
+            {
+                if (cp > 0xDBFF || i == n || s[i] < 0xDC00 || s[i] > 0xDFFF)
+                {
+                    return npos;
+                }
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (s[i++] - 0xDC00);
+            }
+            k += encode_utf8(cp, out + k);
+        }
+        return k;
+    }
+
+    // UTF-32 -> UTF-8：out 至少容纳 4 * n 字节；代理区和超过 U+10FFFF 的值视为非法
+    inline size_t utf32_to_utf8(const char32_t* s, size_t n, char* out) noexcept
+    {
+        size_t i = 0, k = 0;
+        while (i < n)
+        {
+#ifdef STRING_KERNELS_X86
+            // 4 个码点都小于 0x80 时整块收窄
+            if (i + 4 <= n)
+            {
+                __m128i units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+                __m128i high = _mm_and_si128(units, _mm_set1_epi32(static_cast<int>(0xFFFFFF80)));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi32(high, _mm_setzero_si128())) == 0xFFFF)
+                {
+                    __m128i words = _mm_packs_epi32(units, units);
+                    int bytes = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+                    std::memcpy(out + k, &bytes, 4);
+                    i += 4;
+                    k += 4;
+                    continue;
+                }
+            }
+#endif
+            char32_t cp = s[i++];
+            if (cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF))
+            {
+                return npos;
+            }
+            k += encode_utf8(cp, out + k);
+        }
+        return k;
+    }
+}
+
 
 // 用原始指针实现 String 类
+// 短字符串优化 (SSO)：不超过 SSO_CAPACITY 字节的字符串直接存放在对象内部的 m_buf 中，构造、拷贝、移动都不分配堆内存
+// m_data 始终指向有效的、以 '\0' 结尾的缓冲区：短字符串指向 m_buf，长字符串指向堆
+// 容量与长度分开记录：追加时按 2 倍几何增长，逐段拼接的总代价为均摊 O(n)
+// 堆内存从 std::pmr::memory_resource 申请（默认为全局 new/delete）：
+// 请求内的字符串可以共用一个 monotonic_buffer_resource，分配只是指针递增，请求结束时整块释放
+// 查找、比较、求长度走上面 string_kernels 的向量化实现
 class MyString
 {
+public:
+    // 对象内可容纳的最大长度（不含结束符），与 libstdc++ 的 std::string 相同
+    static constexpr size_t SSO_CAPACITY = 15;
+
+    // 查找失败时的返回值
+    static constexpr size_t npos = string_kernels::npos;
+
 private:
     char* m_data;
     size_t m_size;
+    std::pmr::memory_resource* m_resource;
 
-    // 辅助函数：分配内存并复制字符串
+    // 短字符串时使用 m_buf；长字符串时 m_buf 用不上，复用这块空间记录堆容量（不含结束符）
+    union
+    {
+        char m_buf[SSO_CAPACITY + 1];
+        size_t m_capacity;
+    };
+
+    // 辅助函数：从 m_resource 申请 / 归还容量为 cap 的缓冲区（多 1 byte 用于结束符）
+    char* allocate_buffer(size_t cap)
+    {
+        return static_cast<char*>(m_resource->allocate(cap + 1, alignof(char)));
+    }
+
+    void deallocate_buffer(char* p, size_t cap) noexcept
+    {
+        m_resource->deallocate(p, cap + 1, alignof(char));
+    }
+
+    // 辅助函数：当前是否使用对象内缓冲区
+    bool is_local() const noexcept
+    {
+        return m_data == m_buf;
+    }
+
+    // 辅助函数：分配内存并复制字符串；短字符串不分配
+    // 调用前对象须处于空状态（m_data 指向 m_buf）
     void copy_string(const char* str, size_t len)
     {
         // 分配时，多预留 1 byte 用于结束符
+        if (len > SSO_CAPACITY)
+        {
+            m_data = allocate_buffer(len);
+            m_capacity = len;
+        }
         m_size = len;
-        m_data = new char [len + 1];
-        std::memcpy(m_data. str, m_size);
+        std::memcpy(m_data, str, m_size);
         m_data[m_size] = '\0';
     }
 
     // 辅助函数：清空字符串并释放内存
     void cleanUp() noexcept
     {
-        if (m_data)
+        if (!is_local())
         {
-            // 销毁后指针置 null
-            delete[] m_data;
-            m_data = nullptr;
+            // 释放后指针回到对象内缓冲区
+            deallocate_buffer(m_data, m_capacity);
+            m_data = m_buf;
         }
         m_size = 0;
+        m_buf[0] = '\0';
+    }
+
+    // 辅助函数：从 other 接管内容，other 变为空字符串
+    // 短字符串只能复制字节（m_buf 随对象走），长字符串直接转移堆指针（要求两者的 m_resource 相同）
+    void take(MyString& other) noexcept
+    {
+        if (other.is_local())
+        {
+            std::memcpy(m_buf, other.m_buf, other.m_size + 1);
+            m_data = m_buf;
+        }
+        else
+        {
+            m_data = other.m_data;
+            m_capacity = other.m_capacity;
+            other.m_data = other.m_buf;
+        }
+        m_size = other.m_size;
+
+        other.m_size = 0;
+        other.m_buf[0] = '\0';
+    }
+
+    // 辅助函数：换到容量为 new_cap 的堆缓冲区，保留原有内容
+    void reallocate(size_t new_cap)
+    {
+        char* new_data = allocate_buffer(new_cap);
+        std::memcpy(new_data, m_data, m_size + 1);
+        if (!is_local())
+        {
+            deallocate_buffer(m_data, m_capacity);
+        }
+        m_data = new_data;
+        m_capacity = new_cap;
+    }
+
+    // 辅助函数：直接写入 m_data 之后设置长度；按最坏情况预留的容量远大于实际长度时收缩
+    void set_size_after_write(size_t n)
+    {
+        m_size = n;
+        m_data[m_size] = '\0';
+        if (capacity() > 2 * m_size)
+        {
+            shrink_to_fit();
+        }
     }
 
 public:
     // 构造函数：默认、参数、析构、拷贝、移动
-    MyString() : m_data(nullptr), m_size(0) {}
+    // 各构造函数的最后一个参数可指定内存资源，省略时使用 std::pmr::get_default_resource()
+    MyString() noexcept : MyString(std::pmr::get_default_resource()) {}
 
-    // 参数构造：外部调用，从 C 字符串构造
-    explicit MyString(const char* str)
+    explicit MyString(std::pmr::memory_resource* resource) noexcept
+        : m_data(m_buf), m_size(0), m_resource(resource)
     {
-        m_data = nullptr;
-        m_size = 0;
+        m_buf[0] = '\0';
+    }
 
+    // 参数构造：外部调用，从 C 字符串构造
+    explicit MyString(const char* str, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : MyString(resource)
+    {
         if (str)
         {
-            copy_string(str);
-            m_size = std::strlen(str);
+            copy_string(str, string_kernels::length(str));
         }
     }
 
+    // 参数构造：从指定长度的字节构造（可包含 '\0'）
+    MyString(const char* str, size_t len, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : MyString(resource)
+    {
+        copy_string(str, len);
+    }
+
     // 拷贝构造：通过传入的对象，进行复制
-    MyString(MyString& other)
+    // 与 std::pmr::string 一致，拷贝不继承内存资源（副本的生命周期可能超出原对象所在的 arena）
+    MyString(const MyString& other) : MyString()
     {
-        m_data = nullptr;
-        m_size = 0;
+        copy_string(other.m_data, other.m_size);
+    }
 
-        if (other.m_data)
-        {
-            copy_string(other.m_data);
-            m_size = other.m_size;
-        }
+    // 拷贝构造：复制到指定的内存资源
+    MyString(const MyString& other, std::pmr::memory_resource* resource) : MyString(resource)
+    {
+        copy_string(other.m_data, other.m_size);
     }
 
     // 重载拷贝构造运算符：注意 this 指针的判断，并返回当前实例 *this
-    MyString& operator = (MyString& other)
+    MyString& operator = (const MyString& other)
     {
         // 需要使用 this 指针，判断当前示例与入参是否重合
-        if (this != other)
+        if (this != &other)
         {
-            // 先清理本对象，再复制
-            cleanUp();
-            copy_string(other.m_data);
-            m_size = other.m_size;
+            // 现有容量放得下时直接覆盖，不重新分配
+            if (other.m_size <= capacity())
+            {
+                m_size = other.m_size;
+                std::memcpy(m_data, other.m_data, m_size + 1);
+            }
+            else
+            {
+                // 先清理本对象，再复制
+                cleanUp();
+                copy_string(other.m_data, other.m_size);
+            }
         }
 
         // 返回当前对象实例
         return *this;
     }
 
-    // 移动构造：通过 move 转移所有权（自动将原对象置空），且不抛出异常
-    MyString(MyString&& other) noexcept
+    // 移动构造：转移所有权并将原对象置空，且不抛出异常；内存资源随之转移
+    MyString(MyString&& other) noexcept : MyString(other.m_resource)
     {
-        m_data = std::move(other.m_data);
-        m_size = other.m_size;
-
-        other.m_size = 0;
+        take(other);
     }
 
-    // 重载移动构造运算符
-    MyString& operator = (MyString&& other) noexcept
+    // 重载移动构造运算符：内存资源保持不变
+    // 两边资源不同时堆指针不能直接转移（由另一个资源释放），只能复制，因此不是 noexcept
+    MyString& operator = (MyString&& other)
     {
-        if (this != other)
+        if (this != &other)
         {
-            m_data = std::move(other.m_data);
-            m_size = other.m_size;
-
-            other.m_size = 0;
+            if (m_resource == other.m_resource || *m_resource == *other.m_resource)
+            {
+                cleanUp();
+                take(other);
+            }
+            else
+            {
+                *this = other;
+                other.cleanUp();
+            }
         }
 
         return *this;
@@ -110,13 +1223,247 @@ public:
     // 通用方法：返回 C 风格字符串
     const char* get_c_str() const noexcept
     {
-        return m_data ? m_data : "";
+        return m_data;
     }
 
     // 通用方法：返回字符串有效长度
-    const size_t get_size() const noexcept
+    size_t get_size() const noexcept
     {
         return m_size;
     }
-}
 
+    // 通用方法：返回所用的内存资源
+    std::pmr::memory_resource* get_resource() const noexcept
+    {
+        return m_resource;
+    }
+
+    // 通用方法：字符串是否存放在对象内（未分配堆内存）
+    bool is_inline() const noexcept
+    {
+        return is_local();
+    }
+
+    // 通用方法：不重新分配时最多能容纳的长度
+    size_t capacity() const noexcept
+    {
+        return is_local() ? SSO_CAPACITY : m_capacity;
+    }
+
+    // 容量管理：预留至少 new_cap 的容量，已足够时什么都不做
+    void reserve(size_t new_cap)
+    {
+        if (new_cap > capacity())
+        {
+            reallocate(new_cap);
+        }
+    }
+
+    // 容量管理：释放多余容量；长度回到 SSO_CAPACITY 以内时搬回对象内缓冲区
+    void shrink_to_fit()
+    {
+        if (is_local() || m_capacity == m_size)
+        {
+            return;
+        }
+
+        if (m_size <= SSO_CAPACITY)
+        {
+            // m_capacity 与 m_buf 共用空间，先取出再覆盖
+            char* heap = m_data;
+            size_t heap_cap = m_capacity;
+            std::memcpy(m_buf, heap, m_size + 1);
+            m_data = m_buf;
+            deallocate_buffer(heap, heap_cap);
+        }
+        else
+        {
+            reallocate(m_size);
+        }
+    }
+
+    // 追加：容量不足时按 max(所需长度, 2 倍当前容量) 扩容
+    // str 可以指向自身内容：扩容时先复制完再释放旧缓冲区
+    MyString& append(const char* str, size_t len)
+    {
+        size_t new_size = m_size + len;
+        if (new_size > capacity())
+        {
+            size_t new_cap = std::max(new_size, capacity() * 2);
+            char* new_data = allocate_buffer(new_cap);
+            std::memcpy(new_data, m_data, m_size);
+            std::memcpy(new_data + m_size, str, len);
+            if (!is_local())
+            {
+                deallocate_buffer(m_data, m_capacity);
+            }
+            m_data = new_data;
+            m_capacity = new_cap;
+        }
+        else
+        {
+            std::memmove(m_data + m_size, str, len);
+        }
+
+        m_size = new_size;
+        m_data[m_size] = '\0';
+        return *this;
+    }
+
+    MyString& append(const MyString& other)
+    {
+        return append(other.m_data, other.m_size);
+    }
+
+    MyString& append(const char* str)
+    {
+        return str ? append(str, string_kernels::length(str)) : *this;
+    }
+
+    MyString& append(std::string_view sv)
+    {
+        return append(sv.data(), sv.size());
+    }
+
+    MyString& operator += (const MyString& other)
+    {
+        return append(other);
+    }
+
+    MyString& operator += (const char* str)
+    {
+        return append(str);
+    }
+
+    MyString& operator += (std::string_view sv)
+    {
+        return append(sv);
+    }
+
+    MyString& operator += (char c)
+    {
+        return append(&c, 1);
+    }
+
+    // 查找：从 pos 开始第一次出现的位置，找不到返回 npos
+    size_t find(char c, size_t pos = 0) const noexcept
+    {
+        if (pos >= m_size)
+        {
+            return npos;
+        }
+        size_t k = string_kernels::find_char(m_data + pos, m_size - pos, c);
+        return k == npos ? npos : pos + k;
+    }
+
+    size_t find(std::string_view needle, size_t pos = 0) const noexcept
+    {
+        if (pos > m_size)
+        {
+            return npos;
+        }
+        size_t k = string_kernels::find(m_data + pos, m_size - pos, needle.data(), needle.size());
+        return k == npos ? npos : pos + k;
+    }
+
+    // 比较：按无符号字节的字典序，返回负数 / 0 / 正数
+    int compare(std::string_view other) const noexcept
+    {
+        return string_kernels::compare(m_data, m_size, other.data(), other.size());
+    }
+
+    bool starts_with(std::string_view prefix) const noexcept
+    {
+        return prefix.size() <= m_size && string_kernels::equal(m_data, prefix.data(), prefix.size());
+    }
+
+    bool ends_with(std::string_view suffix) const noexcept
+    {
+        return suffix.size() <= m_size && string_kernels::equal(m_data + m_size - suffix.size(), suffix.data(), suffix.size());
+    }
+
+    friend bool operator == (const MyString& a, std::string_view b) noexcept
+    {
+        return a.m_size == b.size() && string_kernels::equal(a.m_data, b.data(), b.size());
+    }
+
+    friend bool operator != (const MyString& a, std::string_view b) noexcept
+    {
+        return !(a == b);
+    }
+
+    friend bool operator < (const MyString& a, std::string_view b) noexcept
+    {
+        return a.compare(b) < 0;
+    }
+
+    // UTF-8：内容是否为合法的 UTF-8
+    bool is_valid_utf8() const noexcept
+    {
+        return string_kernels::validate_utf8(m_data, m_size);
+    }
+
+    // UTF-8：码点个数，要求内容是合法的 UTF-8（否则结果无意义）
+    size_t count_code_points() const noexcept
+    {
+        return string_kernels::count_utf8(m_data, m_size);
+    }
+
+    // 转码：内容不是合法的 UTF-8 时抛出 std::invalid_argument
+    std::u16string to_utf16() const
+    {
+        std::u16string out(m_size, u'\0');
+        size_t n = string_kernels::utf8_to_utf16(m_data, m_size, out.data());
+        if (n == npos)
+        {
+            throw std::invalid_argument("MyString::to_utf16: invalid UTF-8");
+        }
+        out.resize(n);
+        return out;
+    }
+
+    std::u32string to_utf32() const
+    {
+        std::u32string out(m_size, U'\0');
+        size_t n = string_kernels::utf8_to_utf32(m_data, m_size, out.data());
+        if (n == npos)
+        {
+            throw std::invalid_argument("MyString::to_utf32: invalid UTF-8");
+        }
+        out.resize(n);
+        return out;
+    }
+
+    // 转码：含不成对的代理项（UTF-16）或非法码点（UTF-32）时抛出 std::invalid_argument
+    static MyString from_utf16(std::u16string_view text, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+    {
+        MyString result(resource);
+        result.reserve(text.size() * 3);
+        size_t n = string_kernels::utf16_to_utf8(text.data(), text.size(), result.m_data);
+        if (n == npos)
+        {
+            throw std::invalid_argument("MyString::from_utf16: unpaired surrogate");
+        }
+        result.set_size_after_write(n);
+        return result;
+    }
+
+    static MyString from_utf32(std::u32string_view text, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+    {
+        MyString result(resource);
+        result.reserve(text.size() * 4);
+        size_t n = string_kernels::utf32_to_utf8(text.data(), text.size(), result.m_data);
+        if (n == npos)
+        {
+            throw std::invalid_argument("MyString::from_utf32: invalid code point");
+        }
+        result.set_size_after_write(n);
+        return result;
+    }
+
+    // 转换：零拷贝地得到 string_view，视图在字符串下一次修改前有效
+    operator std::string_view() const noexcept
+    {
+        return std::string_view(m_data, m_size);
+    }
+};
@@ -0,0 +1,237 @@
+// MyString 与 std::string 的微基准：耗时与每次操作的堆分配次数
+// 编译：g++ -std=c++17 -O2 MyString_benchmark.cpp -o mystring_bench
+// 用法：./mystring_bench [字符串个数，默认 200000]
+#include "MyString.cpp"
+
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <iomanip>
+#include <new>
+#include <cstdlib>
+
+// 统计堆分配：替换全局 operator new / delete（std::pmr::new_delete_resource 最终也走这里）
+static size_t g_alloc_count = 0;
+
+void* operator new(size_t size)
+{
+    g_alloc_count++;
+    if (void* p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t align)
+{
+    g_alloc_count++;
+    size_t alignment = static_cast<size_t>(align);
+    if (void* p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+
+// 防止编译器把结果没用到的计算整个删掉
+static volatile size_t g_sink;
+
+/*
+ * 长度分布取自线上标签 / 字段的大致比例：
+ *   60% 为 3~15 字节（标签、枚举值，落在 SSO 范围内）
+ *   30% 为 16~64 字节（路径、ID）
+ *   10% 为 65~1024 字节（消息正文片段）
+ * 每项操作对全部样本各做一次，报告每次操作的平均耗时 (ns) 与堆分配次数
+ */
+static std::vector<std::string> make_samples(size_t count)
+{
+    std::mt19937 gen(2024);
+    std::uniform_real_distribution<double> bucket(0.0, 1.0);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::vector<std::string> samples;
+    samples.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        double b = bucket(gen);
+        size_t len = b < 0.6 ? 3 + gen() % 13 : (b < 0.9 ? 16 + gen() % 49 : 65 + gen() % 960);
+        std::string s(len, ' ');
+        for (char& c : s)
+        {
+            c = static_cast<char>(letter(gen));
+        }
+        samples.push_back(std::move(s));
+    }
+    return samples;
+}
+
+struct Result
+{
+    double ns_per_op;
+    double allocs_per_op;
+};
+
+// 计时并统计 body 中的分配次数；body 返回参与计算的结果，防止被优化掉
+template<typename Body>
+static Result measure(size_t ops, Body&& body)
+{
+    size_t allocs_before = g_alloc_count;
+    auto start = std::chrono::steady_clock::now();
+    g_sink = body();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return Result{elapsed.count() / ops, static_cast<double>(g_alloc_count - allocs_before) / ops};
+}
+
+// 对一种字符串类型跑全部操作；StringT 需支持 (const char*, size_t) 构造、+= string_view、==、compare 和到 string_view 的转换
+template<typename StringT>
+static std::vector<Result> run_suite(const std::vector<std::string>& samples)
+{
+    size_t n = samples.size();
+    std::vector<Result> results;
+
+    // 预先构造好一份，供拷贝 / 比较 / 哈希使用（不计入统计）
+    std::vector<StringT> source;
+    source.reserve(n);
+    for (const auto& s : samples)
+    {
+        source.emplace_back(s.data(), s.size());
+    }
+    std::vector<StringT> equal_copy(source);
+
+    // 1. 构造 + 析构
+    results.push_back(measure(n, [&]
+    {
+        size_t acc = 0;
+        for (const auto& s : samples)
+        {
+            StringT str(s.data(), s.size());
+            acc += std::string_view(str).size();
+        }
+        return acc;
+    }));
+
+    // 2. 拷贝构造 + 析构
+    results.push_back(measure(n, [&]
+    {
+        size_t acc = 0;
+        for (const auto& s : source)
+        {
+            StringT copy(s);
+            acc += std::string_view(copy).size();
+        }
+        return acc;
+    }));
+
+    // 3. 移动构造：在两个数组之间来回移动（不含源字符串的构造）
+    std::vector<StringT> moved;
+    moved.reserve(n);
+    results.push_back(measure(n, [&]
+    {
+        for (auto& s : equal_copy)
+        {
+            moved.emplace_back(std::move(s));
+        }
+        size_t acc = 0;
+        for (size_t i = 0; i < n; i++)
+        {
+            equal_copy[i] = std::move(moved[i]);
+            acc += std::string_view(equal_copy[i]).size();
+        }
+        moved.clear();
+        return acc;
+    }));
+
+    // 4. 追加：把每个样本按 8 段拼成一个新字符串
+    results.push_back(measure(n, [&]
+    {
+        size_t acc = 0;
+        for (const auto& s : samples)
+        {
+            StringT built;
+            size_t piece = s.size() / 8 + 1;
+            for (size_t pos = 0; pos < s.size(); pos += piece)
+            {
+                built += std::string_view(s).substr(pos, piece);
+            }
+            acc += std::string_view(built).size();
+        }
+        return acc;
+    }));
+
+    // 5. 相等比较：内容相同的两个对象（最坏情况，需要比较全部字节）
+    results.push_back(measure(n, [&]
+    {
+        size_t acc = 0;
+        for (size_t i = 0; i < n; i++)
+        {
+            acc += source[i] == equal_copy[i];
+        }
+        return acc;
+    }));
+
+    // 6. 三路比较：相邻样本
+    results.push_back(measure(n, [&]
+    {
+        size_t acc = 0;
+        for (size_t i = 0; i + 1 < n; i++)
+        {
+            acc += source[i].compare(std::string_view(source[i + 1])) < 0;
+        }
+        return acc;
+    }));
+
+    // 7. 哈希：两者都经 string_view 使用同一个哈希函数，差别只在取数据的开销
+    results.push_back(measure(n, [&]
+    {
+        size_t acc = 0;
+        for (const auto& s : source)
+        {
+            acc += std::hash<std::string_view>{}(std::string_view(s));
+        }
+        return acc;
+    }));
+
+    return results;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 200000;
+    std::vector<std::string> samples = make_samples(count);
+
+    size_t short_count = 0;
+    for (const auto& s : samples)
+    {
+        short_count += s.size() <= MyString::SSO_CAPACITY;
+    }
+
+    std::cout << count << " 个样本，其中 " << 100.0 * short_count / count << "% 不超过 SSO 容量 "
+              << MyString::SSO_CAPACITY << " 字节；sizeof(std::string) = " << sizeof(std::string)
+              << "，sizeof(MyString) = " << sizeof(MyString) << "\n";
+
+    // 先各跑一遍预热，再正式计时
+    run_suite<std::string>(samples);
+    run_suite<MyString>(samples);
+    std::vector<Result> std_results = run_suite<std::string>(samples);
+    std::vector<Result> my_results = run_suite<MyString>(samples);
+
+    const char* names[] = {"construct", "copy", "move", "append x8", "equal", "compare", "hash"};
+    std::cout << std::left << std::setw(12) << "op" << std::right
+              << std::setw(14) << "std ns/op" << std::setw(14) << "std alloc/op"
+              << std::setw(14) << "My ns/op" << std::setw(14) << "My alloc/op" << "\n";
+    std::cout << std::fixed << std::setprecision(2);
+    for (size_t i = 0; i < std_results.size(); i++)
+    {
+        std::cout << std::left << std::setw(12) << names[i] << std::right
+                  << std::setw(14) << std_results[i].ns_per_op << std::setw(14) << std_results[i].allocs_per_op
+                  << std::setw(14) << my_results[i].ns_per_op << std::setw(14) << my_results[i].allocs_per_op << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,100 @@
+// MyString 查找 / 比较内核基准：各 SIMD 级别对比 std::string 与 libc
+// 编译：g++ -std=c++17 -O2 MyString_search_benchmark.cpp -o mystring_search_bench
+// 用法：./mystring_search_bench [文本字节数，默认 65536]
+#include "MyString.cpp"
+
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <iomanip>
+#include <functional>
+
+// 防止编译器把结果没用到的计算整个删掉
+static volatile size_t g_sink;
+
+// 重复执行 fn，返回每次的平均耗时 (ns)
+static double time_ns(const std::function<size_t()>& fn, int iterations)
+{
+    size_t acc = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+    {
+        acc += fn();
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    g_sink = acc;
+    return elapsed.count() / iterations;
+}
+
+static void print_row(const std::string& name, double ns, size_t bytes)
+{
+    std::cout << "  " << std::left << std::setw(28) << name << std::right << std::setw(10) << std::fixed
+              << std::setprecision(0) << ns << " ns" << std::setw(9) << std::setprecision(2) << bytes / ns << " GB/s\n";
+}
+
+int main(int argc, char* argv[])
+{
+    // 被查找的子串 + 结尾的 '!' 放在文本末尾，前面至少留 1 字节正文
+    const std::string needle = "needle_in_text";
+    const std::string suffix = needle + "!";
+    size_t text_size = argc > 1 ? std::stoul(argv[1]) : 65536;
+    if (text_size < needle.size() + 2)
+    {
+        std::cout << "文本字节数 " << text_size << " 过小，按最小值 " << needle.size() + 2 << " 运行\n";
+        text_size = needle.size() + 2;
+    }
+    int iterations = static_cast<int>(std::max<size_t>(100, (64u << 20) / std::max<size_t>(text_size, 1)));
+
+    // 由小写单词和空格组成的文本；被查找的子串只出现在末尾
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::uniform_int_distribution<int> word_len(2, 9);
+    std::string text;
+    while (text.size() < text_size)
+    {
+        int len = word_len(gen);
+        for (int i = 0; i < len; i++)
+        {
+            text += static_cast<char>(letter(gen));
+        }
+        text += ' ';
+    }
+    text.resize(text_size - suffix.size());
+    text += suffix;
+
+    std::string text_copy = text;
+    MyString my_text(text.data(), text.size());
+    MyString my_copy(text.data(), text.size());
+
+    std::cout << "文本 " << text.size() << " 字节，每项重复 " << iterations << " 次，CPU 支持的最高级别 "
+              << string_kernels::level_name(string_kernels::detect_level()) << "\n";
+
+    // 基线：std::string 与 libc
+    std::cout << "std::string / libc\n";
+    print_row("std::string::find(char)", time_ns([&] { return text.find('!'); }, iterations), text.size());
+    print_row("memchr", time_ns([&] { return static_cast<size_t>(static_cast<const char*>(std::memchr(text.data(), '!', text.size())) - text.data()); }, iterations), text.size());
+    print_row("std::string::find(substr)", time_ns([&] { return text.find(needle); }, iterations), text.size());
+    print_row("strstr", time_ns([&] { return static_cast<size_t>(std::strstr(text.c_str(), needle.c_str()) - text.c_str()); }, iterations), text.size());
+    print_row("std::string::compare", time_ns([&] { return static_cast<size_t>(text.compare(text_copy) + 1); }, iterations), text.size());
+    print_row("memcmp", time_ns([&] { return static_cast<size_t>(std::memcmp(text.data(), text_copy.data(), text.size()) + 1); }, iterations), text.size());
+    print_row("strlen", time_ns([&] { return std::strlen(text.c_str()); }, iterations), text.size());
+
+    // MyString 各级别
+    for (string_kernels::SimdLevel level : {string_kernels::SimdLevel::Scalar, string_kernels::SimdLevel::SSE2, string_kernels::SimdLevel::AVX2})
+    {
+        if (string_kernels::use_level(level) != level)
+        {
+            continue;       // CPU 不支持
+        }
+
+        std::cout << "MyString [" << string_kernels::level_name(level) << "]\n";
+        print_row("find(char)", time_ns([&] { return my_text.find('!'); }, iterations), text.size());
+        print_row("find(substr)", time_ns([&] { return my_text.find(needle); }, iterations), text.size());
+        print_row("compare", time_ns([&] { return static_cast<size_t>(my_text.compare(my_copy) + 1); }, iterations), text.size());
+        print_row("starts_with(全文)", time_ns([&] { return static_cast<size_t>(my_text.starts_with(my_copy)); }, iterations), text.size());
+        print_row("length", time_ns([&] { return string_kernels::length(my_text.get_c_str()); }, iterations), text.size());
+    }
+
+    return 0;
+}
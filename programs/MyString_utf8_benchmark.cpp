@@ -0,0 +1,107 @@
+// MyString UTF-8 校验 / 计数 / 转码吞吐：各 SIMD 级别对比
+// 编译：g++ -std=c++17 -O2 MyString_utf8_benchmark.cpp -o mystring_utf8_bench
+// 用法：./mystring_utf8_bench [文本字节数，默认 1048576]
+#include "MyString.cpp"
+
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <iomanip>
+#include <functional>
+
+// 防止编译器把结果没用到的计算整个删掉
+static volatile size_t g_sink;
+
+// 重复执行 fn，返回吞吐 (GB/s)
+static double throughput(const std::function<size_t()>& fn, size_t bytes, int iterations)
+{
+    size_t acc = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+    {
+        acc += fn();
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    g_sink = acc;
+    return static_cast<double>(bytes) * iterations / elapsed.count();
+}
+
+// 生成约 bytes 字节的文本：ascii_ratio 比例的码点为 ASCII，其余在 2~4 字节码点中均匀选取
+static MyString make_text(size_t bytes, double ascii_ratio, unsigned seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    std::uniform_int_distribution<int> width(2, 4);
+    MyString text;
+    text.reserve(bytes + 4);
+    char buf[4];
+    while (text.get_size() < bytes)
+    {
+        char32_t cp;
+        if (coin(gen) < ascii_ratio)
+        {
+            cp = 0x20 + gen() % 0x5F;
+        }
+        else
+        {
+            switch (width(gen))
+            {
+                case 2: cp = 0x80 + gen() % 0x780; break;
+                case 3: cp = 0x4E00 + gen() % 0x5000; break;        // CJK 统一表意文字
+                default: cp = 0x1F300 + gen() % 0x300; break;      // emoji
+            }
+        }
+        text.append(buf, string_kernels::encode_utf8(cp, buf));
+    }
+    return text;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t text_size = argc > 1 ? std::stoul(argv[1]) : (1 << 20);
+    int iterations = static_cast<int>(std::max<size_t>(10, (256u << 20) / std::max<size_t>(text_size, 1)));
+
+    struct Corpus
+    {
+        const char* name;
+        MyString text;
+    };
+    std::vector<Corpus> corpora;
+    corpora.push_back(Corpus{"纯 ASCII", make_text(text_size, 1.0, 1)});
+    corpora.push_back(Corpus{"90% ASCII", make_text(text_size, 0.9, 2)});
+    corpora.push_back(Corpus{"多字节为主", make_text(text_size, 0.1, 3)});
+
+    std::cout << "文本约 " << text_size << " 字节，每项重复 " << iterations << " 次，单位 GB/s（按 UTF-8 字节计）\n";
+    std::cout << std::left << std::setw(10) << "level" << std::setw(16) << "corpus" << std::right
+              << std::setw(10) << "validate" << std::setw(10) << "count" << std::setw(10) << "->utf16"
+              << std::setw(10) << "->utf32" << std::setw(10) << "utf16->" << "\n";
+
+    for (string_kernels::SimdLevel level : {string_kernels::SimdLevel::Scalar, string_kernels::SimdLevel::SSE2, string_kernels::SimdLevel::AVX2})
+    {
+        if (string_kernels::use_level(level) != level)
+        {
+            continue;       // CPU 不支持
+        }
+
+        for (const Corpus& corpus : corpora)
+        {
+            const MyString& text = corpus.text;
+            size_t bytes = text.get_size();
+            std::u16string utf16 = text.to_utf16();
+
+            double validate = throughput([&] { return static_cast<size_t>(text.is_valid_utf8()); }, bytes, iterations);
+            double count = throughput([&] { return text.count_code_points(); }, bytes, iterations);
+            double to16 = throughput([&] { return text.to_utf16().size(); }, bytes, iterations / 4 + 1);
+            double to32 = throughput([&] { return text.to_utf32().size(); }, bytes, iterations / 4 + 1);
+            double from16 = throughput([&] { return MyString::from_utf16(utf16).get_size(); }, bytes, iterations / 4 + 1);
+
+            std::cout << std::left << std::setw(10) << string_kernels::level_name(level) << std::setw(16) << corpus.name
+                      << std::right << std::fixed << std::setprecision(2)
+                      << std::setw(10) << validate << std::setw(10) << count << std::setw(10) << to16
+                      << std::setw(10) << to32 << std::setw(10) << from16 << "\n";
+        }
+    }
+
+    return 0;
+}
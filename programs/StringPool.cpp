@@ -0,0 +1,283 @@
+// 字符串驻留池 (string interning)
+// 编译：g++ -std=c++17 -O2 -pthread StringPool.cpp -o string_pool
+#include "MyString.cpp"
+
+#include <shared_mutex>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <deque>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <functional>
+#include <chrono>
+
+// 同样内容的字符串只保存一份，调用方拿到一个稳定的句柄 InternedString：
+// (1) 句柄相等 <=> 内容相等，比较只需比较指针
+// (2) 哈希值在驻留时算好存在条目里，取哈希只是读一个字段
+// 池按哈希值分成多个分片，每个分片一把读写锁：已驻留的字符串走读锁（绝大多数调用），只有首次出现才上写锁
+// 条目在池销毁前不会释放，每个分片的字符串内容都从自己的 monotonic_buffer_resource 分配
+
+// 驻留条目：地址在池的生命周期内不变
+struct InternedEntry
+{
+    MyString text;
+    size_t hash;
+    uint32_t id;
+
+    InternedEntry(std::string_view sv, size_t h, uint32_t i, std::pmr::memory_resource* resource)
+        : text(sv.data(), sv.size(), resource), hash(h), id(i)
+    {
+
+    }
+};
+
+// 驻留字符串的句柄：只有一个指针大小，可以随意拷贝
+class InternedString
+{
+private:
+    const InternedEntry* m_entry = nullptr;
+
+public:
+    InternedString() = default;
+    explicit InternedString(const InternedEntry* entry) : m_entry(entry) {}
+
+    // 比较：同一个池中内容相同的字符串必然是同一个条目
+    bool operator == (const InternedString& other) const noexcept
+    {
+        return m_entry == other.m_entry;
+    }
+
+    bool operator != (const InternedString& other) const noexcept
+    {
+        return m_entry != other.m_entry;
+    }
+
+    // 通用方法：预先算好的哈希值
+    size_t hash() const noexcept
+    {
+        return m_entry ? m_entry->hash : 0;
+    }
+
+    // 通用方法：池内唯一的编号，从 0 开始连续分配，可用作数组下标
+    uint32_t id() const noexcept
+    {
+        return m_entry ? m_entry->id : UINT32_MAX;
+    }
+
+    std::string_view view() const noexcept
+    {
+        return m_entry ? std::string_view(m_entry->text) : std::string_view();
+    }
+
+    const char* get_c_str() const noexcept
+    {
+        return m_entry ? m_entry->text.get_c_str() : "";
+    }
+
+    bool empty() const noexcept
+    {
+        return m_entry == nullptr;
+    }
+};
+
+namespace std
+{
+    template<>
+    struct hash<InternedString>
+    {
+        size_t operator()(const InternedString& s) const noexcept
+        {
+            return s.hash();
+        }
+    };
+}
+
+class StringPool
+{
+private:
+    static constexpr size_t SHARD_COUNT = 64;
+
+    // 分片内部的查找键：哈希值已算好，哈希表不再重复计算
+    struct PrehashedKey
+    {
+        std::string_view text;
+        size_t hash;
+
+        bool operator == (const PrehashedKey& other) const noexcept
+        {
+            return hash == other.hash && text == other.text;
+        }
+    };
+
+    struct PrehashedKeyHash
+    {
+        size_t operator()(const PrehashedKey& key) const noexcept
+        {
+            return key.hash;
+        }
+    };
+
+    // 每个分片独占一条缓存行，避免相邻分片的锁互相干扰
+    struct alignas(64) Shard
+    {
+        std::shared_mutex mtx;
+        std::pmr::monotonic_buffer_resource arena;
+        std::deque<InternedEntry> entries;          // deque 追加元素不会移动已有元素
+        std::unordered_map<PrehashedKey, const InternedEntry*, PrehashedKeyHash> index;
+    };
+
+    std::unique_ptr<Shard[]> m_shards;
+    std::atomic<uint32_t> m_next_id{0};
+
+    Shard& shard_for(size_t hash) noexcept
+    {
+        // 哈希表用低位选桶，分片用高位，两者互不相关
+        return m_shards[(hash >> 58) & (SHARD_COUNT - 1)];
+    }
+
+public:
+    StringPool() : m_shards(new Shard[SHARD_COUNT])
+    {
+
+    }
+
+    // 禁用拷贝构造和赋值运算符（句柄指向池内部）
+    StringPool(const StringPool& other) = delete;
+    StringPool& operator = (const StringPool& other) = delete;
+
+    static size_t hash_of(std::string_view sv) noexcept
+    {
+        return std::hash<std::string_view>{}(sv);
+    }
+
+    // 驻留：返回内容为 sv 的唯一句柄，首次出现时复制一份保存到池中
+    InternedString intern(std::string_view sv)
+    {
+        size_t h = hash_of(sv);
+        Shard& shard = shard_for(h);
+        PrehashedKey key{sv, h};
+
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mtx);
+            auto it = shard.index.find(key);
+            if (it != shard.index.end())
+            {
+                return InternedString(it->second);
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock(shard.mtx);
+
+        // 释放读锁到拿到写锁之间，其他线程可能已经插入
+        auto it = shard.index.find(key);
+        if (it != shard.index.end())
+        {
+            return InternedString(it->second);
+        }
+
+        const InternedEntry& entry = shard.entries.emplace_back(sv, h, m_next_id.fetch_add(1, std::memory_order_relaxed), &shard.arena);
+        shard.index.emplace(PrehashedKey{std::string_view(entry.text), h}, &entry);
+        return InternedString(&entry);
+    }
+
+    InternedString intern(const MyString& str)
+    {
+        return intern(std::string_view(str));
+    }
+
+    // 查找：只查不插，不存在时返回空句柄
+    InternedString find(std::string_view sv)
+    {
+        size_t h = hash_of(sv);
+        Shard& shard = shard_for(h);
+        std::shared_lock<std::shared_mutex> lock(shard.mtx);
+        auto it = shard.index.find(PrehashedKey{sv, h});
+        return it != shard.index.end() ? InternedString(it->second) : InternedString();
+    }
+
+    size_t size() const noexcept
+    {
+        return m_next_id.load(std::memory_order_relaxed);
+    }
+};
+
+int main()
+{
+    StringPool pool;
+
+    // 1. 基本用法：内容相同 <=> 句柄相同
+    InternedString a = pool.intern("http.status");
+    InternedString b = pool.intern(MyString("http.status"));
+    InternedString c = pool.intern("http.method");
+    std::cout << a.get_c_str() << " == " << b.get_c_str() << ": " << (a == b) << "，id " << a.id() << "\n";
+    std::cout << a.get_c_str() << " == " << c.get_c_str() << ": " << (a == c) << "，id " << c.id() << "\n";
+
+    // 2. 多线程并发驻留同一批标签：每个标签只保存一份
+    const int label_count = 4000;
+    std::vector<std::string> labels;
+    for (int i = 0; i < label_count; i++)
+    {
+        labels.push_back("service.metric.label_" + std::to_string(i));
+    }
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&pool, &labels, t]
+        {
+            for (int round = 0; round < 50; round++)
+            {
+                for (size_t i = t; i < labels.size() + t; i++)
+                {
+                    pool.intern(labels[i % labels.size()]);
+                }
+            }
+        });
+    }
+    for (auto& th : threads)
+    {
+        th.join();
+    }
+    std::cout << "4 个线程并发驻留 " << label_count << " 个标签后，池中条目数: " << pool.size() << "\n";
+
+    // 3. 作为哈希表的 key：std::string 每次查找都要计算哈希并逐字节比较，驻留句柄只读字段、比指针
+    std::unordered_map<std::string, int> by_string;
+    std::unordered_map<InternedString, int> by_handle;
+    std::vector<InternedString> handles;
+    for (int i = 0; i < label_count; i++)
+    {
+        by_string[labels[i]] = i;
+        handles.push_back(pool.intern(labels[i]));
+        by_handle[handles.back()] = i;
+    }
+
+    const int rounds = 500;
+    long long sum_string = 0, sum_handle = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++)
+    {
+        for (const auto& label : labels)
+        {
+            sum_string += by_string.find(label)->second;
+        }
+    }
+    std::chrono::duration<double, std::milli> string_ms = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++)
+    {
+        for (const auto& handle : handles)
+        {
+            sum_handle += by_handle.find(handle)->second;
+        }
+    }
+    std::chrono::duration<double, std::milli> handle_ms = std::chrono::steady_clock::now() - start;
+
+    std::cout << rounds * label_count << " 次查找：std::string 作 key " << string_ms.count() << " ms，驻留句柄作 key "
+              << handle_ms.count() << " ms" << (sum_string == sum_handle ? "" : "（结果不一致!）") << "\n";
+
+    return 0;
+}
@@ -0,0 +1,334 @@
+// 分段字符串构建器 (rope)：拼接只记录片段，需要连续内存时才展平成 MyString
+// 编译：g++ -std=c++17 -O2 StringRope.cpp -o string_rope
+#include "MyString.cpp"
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <climits>
+#include <cerrno>
+
+#include <fcntl.h>      // open
+#include <sys/uio.h>    // writev / iovec
+#include <unistd.h>     // close
+
+// 大响应由许多片段拼成，直接拼进一个 MyString 时，每次扩容和最后的拷贝都要搬动全部字节
+// StringRope 只保存片段的 {指针, 长度}：
+// (1) append_ref：按引用追加，不复制，调用方保证片段在 rope 使用期间有效（如静态模板、长期缓存的内容）
+// (2) append：复制到 rope 自己的分块缓冲区中，小片段紧挨着存放，相邻的复制片段合并为一段
+// (3) append(MyString&&) / append(StringRope&&)：接管对方的存储，只移动指针（SSO 短字符串直接复制）
+// 每次拼接的代价与片段数有关，与字节数无关；输出时用 writev 直接把片段交给内核，或 flatten 一次性复制成 MyString
+class StringRope
+{
+private:
+    static constexpr size_t CHUNK_SIZE = 4096;
+
+    struct Piece
+    {
+        const char* data;
+        size_t size;
+    };
+
+    std::vector<Piece> m_pieces;
+    size_t m_size = 0;
+
+    // 复制进来的字节：m_chunk 是当前正在填充的分块，写满的分块和单独分配的大片段放在 m_storage
+    std::unique_ptr<char[]> m_chunk;
+    size_t m_chunk_used = CHUNK_SIZE;
+    std::vector<std::unique_ptr<char[]>> m_storage;
+
+    // 接管的 MyString：unique_ptr 保证字符串对象（包括 SSO 的内部缓冲区）地址不变
+    std::vector<std::unique_ptr<MyString>> m_owned;
+
+    // 辅助函数：追加一个片段；与上一个片段在内存中首尾相接时直接延长
+    void push_piece(const char* data, size_t len)
+    {
+        if (len == 0)
+        {
+            return;
+        }
+        if (!m_pieces.empty() && m_pieces.back().data + m_pieces.back().size == data)
+        {
+            m_pieces.back().size += len;
+        }
+        else
+        {
+            m_pieces.push_back(Piece{data, len});
+        }
+        m_size += len;
+    }
+
+    // 辅助函数：在分块缓冲区中取 len 字节；超过半块的大片段单独分配，不浪费当前块的剩余空间
+    char* reserve_bytes(size_t len)
+    {
+        if (len > CHUNK_SIZE / 2)
+        {
+            m_storage.push_back(std::make_unique<char[]>(len));
+            return m_storage.back().get();
+        }
+        if (m_chunk_used + len > CHUNK_SIZE)
+        {
+            if (m_chunk)
+            {
+                m_storage.push_back(std::move(m_chunk));
+            }
+            m_chunk = std::make_unique<char[]>(CHUNK_SIZE);
+            m_chunk_used = 0;
+        }
+        char* p = m_chunk.get() + m_chunk_used;
+        m_chunk_used += len;
+        return p;
+    }
+
+public:
+    StringRope() = default;
+
+    // 禁用拷贝构造和赋值运算符（片段指向自身的缓冲区）；允许移动
+    StringRope(const StringRope& other) = delete;
+    StringRope& operator = (const StringRope& other) = delete;
+
+    // 移动后源对象恢复为空 rope，可以继续使用
+    StringRope(StringRope&& other) noexcept
+        : m_pieces(std::move(other.m_pieces)), m_size(other.m_size), m_chunk(std::move(other.m_chunk)),
+          m_chunk_used(other.m_chunk_used), m_storage(std::move(other.m_storage)), m_owned(std::move(other.m_owned))
+    {
+        other.clear();
+    }
+
+    StringRope& operator = (StringRope&& other) noexcept
+    {
+        if (this != &other)
+        {
+            m_pieces = std::move(other.m_pieces);
+            m_size = other.m_size;
+            m_chunk = std::move(other.m_chunk);
+            m_chunk_used = other.m_chunk_used;
+            m_storage = std::move(other.m_storage);
+            m_owned = std::move(other.m_owned);
+            other.clear();
+        }
+        return *this;
+    }
+
+    // 按引用追加：不复制
+    StringRope& append_ref(std::string_view sv)
+    {
+        push_piece(sv.data(), sv.size());
+        return *this;
+    }
+
+    // 复制追加
+    StringRope& append(std::string_view sv)
+    {
+        if (!sv.empty())
+        {
+            char* p = reserve_bytes(sv.size());
+            std::memcpy(p, sv.data(), sv.size());
+            push_piece(p, sv.size());
+        }
+        return *this;
+    }
+
+    // 接管一个 MyString 的存储：长字符串只转移指针
+    // SSO 范围内的短字符串没有堆缓冲区可接管，直接复制进分块，省去一次 unique_ptr<MyString> 分配
+    StringRope& append(MyString&& str)
+    {
+        if (str.is_inline())
+        {
+            return append(std::string_view(str));
+        }
+        if (str.get_size() > 0)
+        {
+            m_owned.push_back(std::make_unique<MyString>(std::move(str)));
+            push_piece(m_owned.back()->get_c_str(), m_owned.back()->get_size());
+        }
+        return *this;
+    }
+
+    // 拼接另一个 rope：接管它的片段和存储，other 变为空
+    StringRope& append(StringRope&& other)
+    {
+        m_pieces.reserve(m_pieces.size() + other.m_pieces.size());
+        for (const Piece& piece : other.m_pieces)
+        {
+            push_piece(piece.data, piece.size);
+        }
+
+        // other 的全部存储只需保持存活；自己的当前分块不变，剩余空间仍可继续使用
+        if (other.m_chunk)
+        {
+            m_storage.push_back(std::move(other.m_chunk));
+        }
+        for (auto& block : other.m_storage)
+        {
+            m_storage.push_back(std::move(block));
+        }
+        for (auto& owned : other.m_owned)
+        {
+            m_owned.push_back(std::move(owned));
+        }
+
+        other.clear();
+        return *this;
+    }
+
+    StringRope& operator += (std::string_view sv)
+    {
+        return append(sv);
+    }
+
+    StringRope& operator += (MyString&& str)
+    {
+        return append(std::move(str));
+    }
+
+    // 通用方法：总字节数与片段数
+    size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    size_t piece_count() const noexcept
+    {
+        return m_pieces.size();
+    }
+
+    // 遍历：按顺序对每个片段调用 fn(std::string_view)
+    template<typename Fn>
+    void for_each_piece(Fn&& fn) const
+    {
+        for (const Piece& piece : m_pieces)
+        {
+            fn(std::string_view(piece.data, piece.size));
+        }
+    }
+
+    // 导出为 iovec 数组，可直接交给 writev / sendmsg
+    std::vector<iovec> to_iovecs() const
+    {
+        std::vector<iovec> iov;
+        iov.reserve(m_pieces.size());
+        for (const Piece& piece : m_pieces)
+        {
+            iov.push_back(iovec{const_cast<char*>(piece.data), piece.size});
+        }
+        return iov;
+    }
+
+    // 用 writev 写出全部内容，每次最多 IOV_MAX 段，处理部分写入；成功返回 true
+    bool write_to(int fd) const
+    {
+        std::vector<iovec> iov = to_iovecs();
+        size_t first = 0;
+        while (first < iov.size())
+        {
+            int count = static_cast<int>(std::min<size_t>(iov.size() - first, IOV_MAX));
+            ssize_t written = ::writev(fd, iov.data() + first, count);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                return false;
+            }
+
+            // 跳过已写完的段，最后一段可能只写了一部分
+            size_t left = static_cast<size_t>(written);
+            while (first < iov.size() && left >= iov[first].iov_len)
+            {
+                left -= iov[first].iov_len;
+                first++;
+            }
+            if (left > 0)
+            {
+                iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + left;
+                iov[first].iov_len -= left;
+            }
+        }
+        return true;
+    }
+
+    // 展平：一次分配、每个字节只复制一次
+    MyString flatten(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const
+    {
+        MyString result(resource);
+        result.reserve(m_size);
+        for (const Piece& piece : m_pieces)
+        {
+            result.append(piece.data, piece.size);
+        }
+        return result;
+    }
+
+    void clear() noexcept
+    {
+        m_pieces.clear();
+        m_chunk.reset();
+        m_storage.clear();
+        m_owned.clear();
+        m_size = 0;
+        m_chunk_used = CHUNK_SIZE;
+    }
+};
+
+int main()
+{
+    // 1. 基本用法
+    static const char header[] = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n\r\n";
+    StringRope rope;
+    rope.append_ref(header);
+    rope += "{\"items\":[";
+    rope += MyString("\"a fairly long string moved into the rope\"");
+    rope += "]}";
+    MyString flat = rope.flatten();
+    std::cout << rope.piece_count() << " 个片段，" << rope.size() << " 字节 -> " << flat.get_c_str() << "\n";
+
+    // 2. 组装约 300 KB 的响应：2 万个小片段 + 10 段引用的 16 KB 模板
+    std::string big_template(16 * 1024, 't');
+    std::vector<std::string> fragments;
+    for (int i = 0; i < 20000; i++)
+    {
+        fragments.push_back("\"k" + std::to_string(i) + "\",");
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    StringRope response;
+    for (size_t i = 0; i < fragments.size(); i++)
+    {
+        response.append(fragments[i]);
+        if (i % 2000 == 0)
+        {
+            response.append_ref(big_template);
+        }
+    }
+    std::chrono::duration<double, std::micro> rope_us = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    MyString direct;
+    for (size_t i = 0; i < fragments.size(); i++)
+    {
+        direct += fragments[i];
+        if (i % 2000 == 0)
+        {
+            direct += big_template;
+        }
+    }
+    std::chrono::duration<double, std::micro> direct_us = std::chrono::steady_clock::now() - start;
+
+    std::cout << "组装 " << response.size() << " 字节：rope " << rope_us.count() << " us（" << response.piece_count()
+              << " 个片段），直接拼接 MyString " << direct_us.count() << " us\n";
+
+    // 3. 输出：writev 直接写片段，不需要先展平
+    int fd = ::open("/dev/null", O_WRONLY);
+    start = std::chrono::steady_clock::now();
+    bool ok = response.write_to(fd);
+    std::chrono::duration<double, std::micro> write_us = std::chrono::steady_clock::now() - start;
+    ::close(fd);
+
+    MyString flattened = response.flatten();
+    std::cout << "writev 输出 " << (ok ? "成功" : "失败") << "，" << write_us.count() << " us；展平后与直接拼接结果"
+              << (flattened == direct ? "一致" : "不一致") << "\n";
+
+    return 0;
+}
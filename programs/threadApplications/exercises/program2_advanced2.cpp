@@ -19,7 +19,7 @@ template<typename T>
 class SafeQueue
 {
 private:
-    queue<int> queue_;
+    queue<T> queue_;
     mutex mtx_;
     mutex cout_mtx;    // 信息输出专属锁，避免多个线程同时调用 cout, 导致输出产生“信道交织”
     condition_variable cv_;
@@ -0,0 +1,384 @@
+// C++ 线程的使用
+// 练习2（进阶3）：无锁有界 MPMC 环形队列，替代 SafeQueue
+// 编译：g++ -std=c++17 -O2 -pthread program2_advanced3.cpp -o mpmc_queue
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <memory>
+#include <chrono>
+#include <iomanip>
+
+using namespace std;
+
+// SafeQueue 每次 push / tryPop 都要抢同一把锁，线程越多，时间越多地花在锁的争用和线程切换上
+// MPMCQueue 是 Dmitry Vyukov 的有界多生产者多消费者队列：
+// (1) 环形数组，容量为 2 的幂，每个槽位带一个序号 seq，表示这个槽位当前“轮到谁”：
+//     seq == pos       空槽，等待第 pos 次入队
+//     seq == pos + 1   已写入，等待第 pos 次出队
+//     出队后 seq = pos + 容量，等待下一圈的入队
+// (2) 生产者 / 消费者各自用 CAS 推进 tail_ / head_ 抢占位置，抢到后独占该槽位读写，不需要锁
+// (3) head_ 和 tail_ 各占一条缓存行，生产者和消费者不会因为伪共享互相拖慢
+// 只有队列空（或满）时才需要等待：先自旋，再 yield，最后才在条件变量上睡眠
+template<typename T>
+class MPMCQueue
+{
+private:
+    static constexpr size_t CACHE_LINE = 64;
+    static constexpr int SPIN_LIMIT = 64;
+    static constexpr int YIELD_LIMIT = 16;
+
+    struct Slot
+    {
+        atomic<size_t> seq;
+        T data;                 // 要求 T 可默认构造、可移动赋值
+    };
+
+    unique_ptr<Slot[]> slots_;
+    const size_t mask_;
+
+    alignas(CACHE_LINE) atomic<size_t> head_{0};     // 下一次出队的位置，消费者推进
+    alignas(CACHE_LINE) atomic<size_t> tail_{0};     // 下一次入队的位置，生产者推进
+
+    // 以下只在慢路径（需要睡眠）时使用
+    alignas(CACHE_LINE) atomic<bool> isFinished_{false};
+    atomic<int> waitingConsumers_{0};
+    atomic<int> waitingProducers_{0};
+    mutex wait_mtx_;
+    condition_variable notEmpty_;
+    condition_variable notFull_;
+
+    static size_t roundUpPow2(size_t n)
+    {
+        size_t cap = 2;
+        while (cap < n)
+        {
+            cap <<= 1;
+        }
+        return cap;
+    }
+
+    static void cpuRelax()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#else
+        this_thread::yield();
+#endif
+    }
+
+    // 唤醒睡眠中的对方
+    // 【重要】与 sleepUntil 中的两个 seq_cst 栅栏配对：要么这里看到了等待计数，要么对方在睡前的检查中看到了本次修改，不会丢失唤醒
+    void wake(atomic<int>& waiters, condition_variable& cv)
+    {
+        atomic_thread_fence(memory_order_seq_cst);
+        if (waiters.load(memory_order_relaxed) > 0)
+        {
+            // 持锁通知：对方要么还没进入 wait（检查条件时会看到新状态），要么已经在 wait 中
+            lock_guard<mutex> lock(wait_mtx_);
+            cv.notify_one();
+        }
+    }
+
+    template<typename Pred>
+    void sleepUntil(atomic<int>& waiters, condition_variable& cv, Pred ready)
+    {
+        unique_lock<mutex> lock(wait_mtx_);
+        waiters.fetch_add(1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        cv.wait(lock, ready);
+        waiters.fetch_sub(1, memory_order_relaxed);
+    }
+
+    // 退避：前几轮自旋，之后让出 CPU，返回 false 表示该去睡眠了
+    static bool backoff(int& round)
+    {
+        round++;
+        if (round <= SPIN_LIMIT)
+        {
+            cpuRelax();
+            return true;
+        }
+        if (round <= SPIN_LIMIT + YIELD_LIMIT)
+        {
+            this_thread::yield();
+            return true;
+        }
+        return false;
+    }
+
+    // 睡眠条件只看 head_ / tail_：位置被抢占但尚未写完的槽位会造成一次虚假唤醒，醒来后重新尝试即可
+    bool hasItems() const
+    {
+        return tail_.load(memory_order_relaxed) != head_.load(memory_order_relaxed);
+    }
+
+    bool hasSpace() const
+    {
+        return tail_.load(memory_order_relaxed) - head_.load(memory_order_relaxed) <= mask_;
+    }
+
+public:
+    explicit MPMCQueue(size_t capacity = 1024)
+        : slots_(new Slot[roundUpPow2(capacity)]), mask_(roundUpPow2(capacity) - 1)
+    {
+        for (size_t i = 0; i <= mask_; i++)
+        {
+            slots_[i].seq.store(i, memory_order_relaxed);
+        }
+    }
+
+    // 禁用拷贝构造和赋值运算符
+    MPMCQueue(const MPMCQueue& other) = delete;
+    MPMCQueue& operator = (const MPMCQueue& other) = delete;
+
+    size_t capacity() const
+    {
+        return mask_ + 1;
+    }
+
+    // 非阻塞入队：队列满时返回 false，val 保持不变
+    bool tryPush(T& val)
+    {
+        size_t pos = tail_.load(memory_order_relaxed);
+        Slot* slot;
+        for (;;)
+        {
+            slot = &slots_[pos & mask_];
+            size_t seq = slot->seq.load(memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0)
+            {
+                // 空槽：抢占这个位置，失败时 pos 被更新为最新的 tail_
+                if (tail_.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                // 槽位还是上一圈的数据，没被取走：队列满
+                return false;
+            }
+            else
+            {
+                // 其他生产者已经抢走了这个位置
+                pos = tail_.load(memory_order_relaxed);
+            }
+        }
+
+        slot->data = std::move(val);
+        slot->seq.store(pos + 1, memory_order_release);     // 发布：消费者看到 seq 后才会读 data
+        wake(waitingConsumers_, notEmpty_);
+        return true;
+    }
+
+    // 非阻塞出队：队列空时返回 false
+    bool tryDequeue(T& value)
+    {
+        size_t pos = head_.load(memory_order_relaxed);
+        Slot* slot;
+        for (;;)
+        {
+            slot = &slots_[pos & mask_];
+            size_t seq = slot->seq.load(memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0)
+            {
+                if (head_.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                // 槽位尚未写入：队列空（或生产者抢到位置还没写完）
+                return false;
+            }
+            else
+            {
+                pos = head_.load(memory_order_relaxed);
+            }
+        }
+
+        value = std::move(slot->data);
+        slot->seq.store(pos + mask_ + 1, memory_order_release);    // 归还槽位给下一圈的生产者
+        wake(waitingProducers_, notFull_);
+        return true;
+    }
+
+    // 阻塞入队：与 SafeQueue::push 用法相同，队列满时等待消费者腾出位置
+    void push(T val)
+    {
+        int round = 0;
+        while (!tryPush(val))
+        {
+            if (!backoff(round))
+            {
+                sleepUntil(waitingProducers_, notFull_, [this] { return hasSpace(); });
+                round = 0;
+            }
+        }
+    }
+
+    // 所有生产者都结束后调用一次，唤醒全部等待中的消费者
+    void setFinished()
+    {
+        {
+            lock_guard<mutex> lock(wait_mtx_);
+            isFinished_.store(true, memory_order_release);
+        }
+        notEmpty_.notify_all();
+    }
+
+    // 阻塞出队：与 SafeQueue::tryPop 语义相同，队列空且已结束时返回 false，消费者据此退出
+    bool tryPop(T& value)
+    {
+        int round = 0;
+        for (;;)
+        {
+            if (tryDequeue(value))
+            {
+                return true;
+            }
+
+            // 结束标志在所有入队之后设置：看到它时剩余数据都已发布，再取一次即可判断是否真的取完
+            if (isFinished_.load(memory_order_acquire))
+            {
+                return tryDequeue(value);
+            }
+
+            if (!backoff(round))
+            {
+                sleepUntil(waitingConsumers_, notEmpty_, [this] { return hasItems() || isFinished_.load(memory_order_relaxed); });
+                round = 0;
+            }
+        }
+    }
+};
+
+// 对照组：与 SafeQueue 相同的 互斥锁 + 条件变量 实现（去掉日志输出，只比较队列本身）
+template<typename T>
+class MutexQueue
+{
+private:
+    queue<T> queue_;
+    mutex mtx_;
+    condition_variable cv_;
+    bool isFinished_ = false;
+
+public:
+    void push(T val)
+    {
+        lock_guard<mutex> lock(mtx_);
+        queue_.push(std::move(val));
+        cv_.notify_one();
+    }
+
+    void setFinished()
+    {
+        lock_guard<mutex> lock(mtx_);
+        isFinished_ = true;
+        cv_.notify_all();
+    }
+
+    bool tryPop(T& value)
+    {
+        unique_lock<mutex> lock(mtx_);
+        cv_.wait(lock, [this] { return !queue_.empty() || isFinished_; });
+        if (queue_.empty() && isFinished_)
+        {
+            return false;
+        }
+        value = std::move(queue_.front());
+        queue_.pop();
+        return true;
+    }
+};
+
+// nums_prod 个生产者各入队 per_producer 个数，nums_cons 个消费者取完为止
+// 返回每秒处理的元素数（百万），同时校验所有元素恰好被取出一次
+template<typename Queue>
+double run_bench(Queue& q, int nums_prod, int nums_cons, long long per_producer)
+{
+    atomic<long long> consumed_sum{0};
+    atomic<long long> consumed_count{0};
+
+    auto start = chrono::steady_clock::now();
+
+    vector<thread> threads_prod;
+    vector<thread> threads_cons;
+    for (int i = 0; i < nums_prod; i++)
+    {
+        threads_prod.emplace_back([&q, i, per_producer]
+        {
+            for (long long k = 0; k < per_producer; k++)
+            {
+                q.push(i * per_producer + k);
+            }
+        });
+    }
+    for (int i = 0; i < nums_cons; i++)
+    {
+        threads_cons.emplace_back([&q, &consumed_sum, &consumed_count]
+        {
+            long long value;
+            long long sum = 0;
+            long long count = 0;
+            while (q.tryPop(value))
+            {
+                sum += value;
+                count++;
+            }
+            consumed_sum += sum;
+            consumed_count += count;
+        });
+    }
+
+    for (auto& t : threads_prod)
+    {
+        t.join();
+    }
+    // 所有生产者结束后再设置结束标志（SafeQueue 在任一生产者结束时就设置，多生产者下消费者可能提前退出）
+    q.setFinished();
+    for (auto& t : threads_cons)
+    {
+        t.join();
+    }
+
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    long long total = nums_prod * per_producer;
+    if (consumed_count != total || consumed_sum != total * (total - 1) / 2)
+    {
+        cout << "校验失败：取出 " << consumed_count << " 个，应为 " << total << "\n";
+    }
+    return total / elapsed.count() / 1e6;
+}
+
+int main(int argc, char* argv[])
+{
+    long long total_items = argc > 1 ? stoll(argv[1]) : 4000000;
+
+    cout << "硬件线程数: " << thread::hardware_concurrency() << "，每组共传递 " << total_items << " 个元素，单位：百万个/秒\n";
+    cout << left << setw(16) << "生产者+消费者" << right << setw(14) << "MutexQueue" << setw(14) << "MPMCQueue" << "\n";
+
+    for (int pairs : {1, 2, 4, 8})
+    {
+        long long per_producer = total_items / pairs;
+
+        MutexQueue<long long> mutex_queue;
+        double mutex_rate = run_bench(mutex_queue, pairs, pairs, per_producer);
+
+        MPMCQueue<long long> ring_queue(1024);
+        double ring_rate = run_bench(ring_queue, pairs, pairs, per_producer);
+
+        cout << left << setw(16) << (to_string(pairs) + "+" + to_string(pairs)) << right << fixed << setprecision(2)
+             << setw(14) << mutex_rate << setw(14) << ring_rate << "\n";
+    }
+
+    return 0;
+}
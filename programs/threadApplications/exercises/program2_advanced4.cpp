@@ -0,0 +1,342 @@
+// C++ 线程的使用
+// 练习2（进阶4）：单生产者 / 单消费者 (SPSC) 无锁通道，替代 互斥锁 + 条件变量 的一对一交接
+// 编译：g++ -std=c++17 -O2 -pthread program2_advanced4.cpp -o spsc_channel（仅 Linux：慢路径使用 futex）
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <iostream>
+#include <queue>
+#include <memory>
+#include <chrono>
+#include <iomanip>
+#include <cstdint>
+
+#include <linux/futex.h>    // FUTEX_WAIT_PRIVATE / FUTEX_WAKE_PRIVATE
+#include <sys/syscall.h>    // SYS_futex
+#include <unistd.h>         // syscall
+
+using namespace std;
+
+// program2.cpp / simpleThreadAsync.cpp 中的生产者和消费者是严格一对一的，却每个元素都要加锁、notify 一次
+// 只有一个生产者和一个消费者时，不需要任何 CAS：
+// (1) tail_ 只由生产者写，head_ 只由消费者写，各自 store(release) 发布，对方 load(acquire) 读取
+// (2) 双方各缓存一份对方的下标（cachedHead_ / cachedTail_），只有缓存值显示满 / 空时才去读对方的缓存行
+//     连续收发时，每个元素通常只访问自己的缓存行，这是 SPSC 队列快的关键
+// (3) 快路径不加锁、不进内核；只有通道空（或满）且自旋一段时间后，才用 futex 睡眠
+template<typename T>
+class SpscChannel
+{
+private:
+    static constexpr size_t CACHE_LINE = 64;
+    static constexpr int SPIN_LIMIT = 128;
+    static constexpr int YIELD_LIMIT = 16;
+
+    unique_ptr<T[]> buf_;       // 要求 T 可默认构造、可移动赋值
+    const size_t mask_;
+
+    // 消费者的缓存行：读下标 + 缓存的写下标
+    alignas(CACHE_LINE) atomic<size_t> head_{0};
+    size_t cachedTail_ = 0;
+
+    // 生产者的缓存行：写下标 + 缓存的读下标
+    alignas(CACHE_LINE) atomic<size_t> tail_{0};
+    size_t cachedHead_ = 0;
+
+    // 慢路径：睡眠标志兼作 futex 字，1 表示对应一方正在（或即将）睡眠
+    alignas(CACHE_LINE) atomic<uint32_t> consumerSleeping_{0};
+    atomic<uint32_t> producerSleeping_{0};
+    atomic<bool> isClosed_{false};
+
+    static size_t roundUpPow2(size_t n)
+    {
+        size_t cap = 2;
+        while (cap < n)
+        {
+            cap <<= 1;
+        }
+        return cap;
+    }
+
+    static void cpuRelax()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#else
+        this_thread::yield();
+#endif
+    }
+
+    // futex：值仍等于 expected 时才睡眠，由内核原子地检查，不会错过检查之后的唤醒
+    static void futexWait(atomic<uint32_t>& word, uint32_t expected)
+    {
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+    }
+
+    static void futexWake(atomic<uint32_t>& word)
+    {
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+    }
+
+    // 发布数据（或腾出空间）后调用：对方在睡眠时才进内核唤醒
+    // 【重要】栅栏与 sleepUntil 中的栅栏配对：要么这里看到睡眠标志，要么对方睡前的检查看到了本次发布
+    static void wakeIfSleeping(atomic<uint32_t>& sleeping)
+    {
+        atomic_thread_fence(memory_order_seq_cst);
+        if (sleeping.load(memory_order_relaxed) != 0)
+        {
+            sleeping.store(0, memory_order_relaxed);
+            futexWake(sleeping);
+        }
+    }
+
+    // 先登记睡眠标志，再检查一次条件，条件仍不满足才真正睡眠
+    // 标志已被对方清零时 futexWait 立即返回
+    template<typename Pred>
+    static void sleepUntil(atomic<uint32_t>& sleeping, Pred ready)
+    {
+        sleeping.store(1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        if (!ready())
+        {
+            futexWait(sleeping, 1);
+        }
+        sleeping.store(0, memory_order_relaxed);
+    }
+
+    // 退避：前几轮自旋，之后让出 CPU，返回 false 表示该去睡眠了
+    static bool backoff(int& round)
+    {
+        round++;
+        if (round <= SPIN_LIMIT)
+        {
+            cpuRelax();
+            return true;
+        }
+        if (round <= SPIN_LIMIT + YIELD_LIMIT)
+        {
+            this_thread::yield();
+            return true;
+        }
+        return false;
+    }
+
+public:
+    explicit SpscChannel(size_t capacity = 1024)
+        : buf_(new T[roundUpPow2(capacity)]), mask_(roundUpPow2(capacity) - 1)
+    {
+
+    }
+
+    // 禁用拷贝构造和赋值运算符
+    SpscChannel(const SpscChannel& other) = delete;
+    SpscChannel& operator = (const SpscChannel& other) = delete;
+
+    size_t capacity() const
+    {
+        return mask_ + 1;
+    }
+
+    // 以下 tryPush / push / close 只能由生产者线程调用
+
+    // 非阻塞发送：通道满时返回 false，val 保持不变
+    bool tryPush(T& val)
+    {
+        size_t tail = tail_.load(memory_order_relaxed);
+        if (tail - cachedHead_ > mask_)
+        {
+            // 缓存的读下标显示已满，才去读消费者的最新进度
+            cachedHead_ = head_.load(memory_order_acquire);
+            if (tail - cachedHead_ > mask_)
+            {
+                return false;
+            }
+        }
+
+        buf_[tail & mask_] = std::move(val);
+        tail_.store(tail + 1, memory_order_release);
+        wakeIfSleeping(consumerSleeping_);
+        return true;
+    }
+
+    // 阻塞发送：通道满时等待消费者取走数据
+    void push(T val)
+    {
+        int round = 0;
+        while (!tryPush(val))
+        {
+            if (!backoff(round))
+            {
+                sleepUntil(producerSleeping_, [this]
+                {
+                    return tail_.load(memory_order_relaxed) - head_.load(memory_order_acquire) <= mask_;
+                });
+                round = 0;
+            }
+        }
+    }
+
+    // 生产结束：消费者取完剩余数据后 tryPop 返回 false
+    void close()
+    {
+        isClosed_.store(true, memory_order_release);
+        wakeIfSleeping(consumerSleeping_);
+    }
+
+    // 以下 tryDequeue / tryPop 只能由消费者线程调用
+
+    // 非阻塞接收：通道空时返回 false
+    bool tryDequeue(T& value)
+    {
+        size_t head = head_.load(memory_order_relaxed);
+        if (head == cachedTail_)
+        {
+            cachedTail_ = tail_.load(memory_order_acquire);
+            if (head == cachedTail_)
+            {
+                return false;
+            }
+        }
+
+        value = std::move(buf_[head & mask_]);
+        head_.store(head + 1, memory_order_release);
+        wakeIfSleeping(producerSleeping_);
+        return true;
+    }
+
+    // 阻塞接收：与 SafeQueue::tryPop 语义相同，通道空且已关闭时返回 false
+    bool tryPop(T& value)
+    {
+        int round = 0;
+        for (;;)
+        {
+            if (tryDequeue(value))
+            {
+                return true;
+            }
+
+            // close 在最后一次 push 之后调用：看到关闭标志时剩余数据都已发布
+            if (isClosed_.load(memory_order_acquire))
+            {
+                return tryDequeue(value);
+            }
+
+            if (!backoff(round))
+            {
+                sleepUntil(consumerSleeping_, [this]
+                {
+                    return tail_.load(memory_order_acquire) != head_.load(memory_order_relaxed) || isClosed_.load(memory_order_acquire);
+                });
+                round = 0;
+            }
+        }
+    }
+};
+
+// 对照组：program2.cpp 的做法，互斥锁 + 条件变量 保护 std::queue（去掉日志输出和 sleep）
+template<typename T>
+class MutexChannel
+{
+private:
+    queue<T> queue_;
+    mutex mtx_;
+    condition_variable cv_;
+    bool isFinished_ = false;
+
+public:
+    void push(T val)
+    {
+        {
+            lock_guard<mutex> lock(mtx_);
+            queue_.push(std::move(val));
+        }
+        cv_.notify_one();
+    }
+
+    void close()
+    {
+        {
+            lock_guard<mutex> lock(mtx_);
+            isFinished_ = true;
+        }
+        cv_.notify_all();
+    }
+
+    bool tryPop(T& value)
+    {
+        unique_lock<mutex> lock(mtx_);
+        cv_.wait(lock, [this] { return !queue_.empty() || isFinished_; });
+        if (queue_.empty() && isFinished_)
+        {
+            return false;
+        }
+        value = std::move(queue_.front());
+        queue_.pop();
+        return true;
+    }
+};
+
+// 一个生产者发送 0..items-1，一个消费者全部取出；返回每个元素的平均交接耗时 (ns)，并校验顺序
+template<typename Channel>
+double run_bench(Channel& ch, long long items)
+{
+    bool inOrder = true;
+    long long received = 0;
+
+    auto start = chrono::steady_clock::now();
+
+    thread t_cons([&ch, &inOrder, &received]
+    {
+        long long value;
+        while (ch.tryPop(value))
+        {
+            inOrder = inOrder && value == received;
+            received++;
+        }
+    });
+
+    thread t_prod([&ch, items]
+    {
+        for (long long i = 0; i < items; i++)
+        {
+            ch.push(i);
+        }
+        ch.close();
+    });
+
+    t_prod.join();
+    t_cons.join();
+
+    chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+
+    if (!inOrder || received != items)
+    {
+        cout << "校验失败：收到 " << received << " 个，应为 " << items << (inOrder ? "" : "，顺序错乱") << "\n";
+    }
+    return elapsed.count() / items;
+}
+
+int main(int argc, char* argv[])
+{
+    long long items = argc > 1 ? stoll(argv[1]) : 10000000;
+
+    cout << "硬件线程数: " << thread::hardware_concurrency() << "，一对一传递 " << items << " 个元素\n";
+
+    // 各跑两遍，取第二遍（第一遍用于预热）
+    double mutex_ns = 0;
+    double spsc_ns = 0;
+    for (int round = 0; round < 2; round++)
+    {
+        MutexChannel<long long> mutex_channel;
+        mutex_ns = run_bench(mutex_channel, items);
+
+        SpscChannel<long long> spsc_channel(1024);
+        spsc_ns = run_bench(spsc_channel, items);
+    }
+
+    cout << fixed << setprecision(1);
+    cout << "互斥锁 + 条件变量: " << setw(8) << mutex_ns << " ns/元素\n";
+    cout << "SPSC 通道:         " << setw(8) << spsc_ns << " ns/元素\n";
+
+    return 0;
+}